@@ -0,0 +1,451 @@
+#ifndef __BLOP_ALLOC_H__
+#define __BLOP_ALLOC_H__
+
+#include <stddef.h>
+#include <blop/blop.h>
+
+/* Every size class block, header included, fits in ALLOC_BLOCK_BYTES (power of two) and is aligned to it, the same for all classes */
+#ifndef ALLOC_BLOCK_BYTES
+  #define ALLOC_BLOCK_BYTES ((size_t)128 << 10)
+#endif /* ALLOC_BLOCK_BYTES */
+
+#define ALLOC_BLOCK_ALIGN  ALLOC_BLOCK_BYTES
+/* Room left for the block header, enough for the allocation bitmap of the smallest class */
+#define ALLOC_BLOCK_HEADER (ALLOC_BLOCK_BYTES / 16 / 8 + 128)
+
+/* Occupancy histogram resolution of every class in blop_alloc_stats */
+#ifndef ALLOC_STATS_BUCKETS
+  #define ALLOC_STATS_BUCKETS 8
+#endif /* ALLOC_STATS_BUCKETS */
+
+#ifdef OS_POSIX
+  #include <unistd.h>
+  #include <sys/mman.h>
+#endif /* OS_POSIX */
+
+/* Two classes per power of two, all multiples of 16. Requests above the last class are mapped on their own */
+#define ALLOC_CLASSES(X) \
+  X(0,  16)    X(1,  32)    X(2,  48)    X(3,  64)    X(4,  96)    X(5,  128)   \
+  X(6,  192)   X(7,  256)   X(8,  384)   X(9,  512)   X(10, 768)   X(11, 1024)  \
+  X(12, 1536)  X(13, 2048)  X(14, 3072)  X(15, 4096)  X(16, 6144)  X(17, 8192)  \
+  X(18, 12288) X(19, 16384) X(20, 24576) X(21, 32768)
+
+#define ALLOC_CLASSES_COUNT 22
+#define ALLOC_LARGE         32768
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void    blop_alloc_init       (void);
+
+void    blop_free             (void* ptr);
+void*   blop_alloc            (size_t size);
+void*   blop_calloc           (size_t count, size_t size);
+void*   blop_realloc          (void* ptr, size_t size);
+size_t  blop_alloc_usable     (void* ptr);
+
+/* The counters of every class slab (see the slab stats) and the large allocations mapped on their own */
+typedef struct AllocClassStats {
+  size_t            size;
+  size_t            blocks;
+  size_t            block_bytes;
+  size_t            capacity;
+  size_t            live;
+  size_t            peak;
+  size_t            allocs;
+  size_t            frees;
+  size_t            histogram[ALLOC_STATS_BUCKETS + 1];
+} AllocClassStats;
+
+typedef struct AllocStats {
+  AllocClassStats   classes[ALLOC_CLASSES_COUNT];
+  size_t            large_count;
+  size_t            large_bytes;
+} AllocStats;
+
+size_t  blop_alloc_size       (void);
+size_t  blop_alloc_bytes      (void);
+void    blop_alloc_print_out  (void);
+void    blop_alloc_print_err  (void);
+
+void    blop_alloc_stats      (AllocStats* stats);
+void    blop_alloc_dump_out   (void);
+void    blop_alloc_dump_err   (void);
+
+/* Declared first so the slabs below can use the MEM_* hooks when they point here */
+#define ALLOC_CLASS 16
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 32
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 48
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 64
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 96
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 128
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 192
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 256
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 384
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 512
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 768
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 1024
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 1536
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 2048
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 3072
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 4096
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 6144
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 8192
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 12288
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 16384
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 24576
+#include <blop/alloc_class.h>
+#define ALLOC_CLASS 32768
+#include <blop/alloc_class.h>
+
+#ifdef ALLOC_IMPLEMENTATION
+
+/* A large allocation starts with this header at an ALLOC_BLOCK_ALIGN boundary, where a class block keeps its slab pointer */
+typedef union AllocLarge {
+  struct {
+    void*       slab;
+    size_t      size;
+    size_t      mapped;
+  } hdr;
+  max_align_t   align;
+} AllocLarge;
+
+#define ALLOC_SLAB_MEMBER(i, size)  CONCAT2(AllocSlab, size) CONCAT2(slab, size);
+#define ALLOC_CLASS_SIZE(i, size)   size,
+
+/* Sharing one array lets blop_free turn a block's slab pointer back into its class index with a subtraction */
+static union AllocSlabs {
+  ALLOC_CLASSES(ALLOC_SLAB_MEMBER)
+} alloc_slabs[ALLOC_CLASSES_COUNT];
+
+static const size_t alloc_class_sizes[ALLOC_CLASSES_COUNT] = { ALLOC_CLASSES(ALLOC_CLASS_SIZE) };
+
+static int alloc_ready = false;
+
+static struct {
+  RWLOCK_TYPE       lock;
+  size_t            count;
+  size_t            bytes;
+} alloc_large;
+
+#define ALLOC_CLASS_FUNCTIONS(i, size)                                                          \
+  static void*  CONCAT2(alloc_class_alloc, size)(void) {                                        \
+    CONCAT3(alloc_slab, size, _wrlock)(&alloc_slabs[i].CONCAT2(slab, size));                    \
+    void* ptr = CONCAT3(alloc_slab, size, _alloc)(&alloc_slabs[i].CONCAT2(slab, size));         \
+    CONCAT3(alloc_slab, size, _wrunlock)(&alloc_slabs[i].CONCAT2(slab, size));                  \
+    return ptr;                                                                                 \
+  }                                                                                             \
+  static void   CONCAT2(alloc_class_free, size)(void* ptr) {                                    \
+    CONCAT3(alloc_slab, size, _wrlock)(&alloc_slabs[i].CONCAT2(slab, size));                    \
+    CONCAT3(alloc_slab, size, _free)(&alloc_slabs[i].CONCAT2(slab, size), (CONCAT2(AllocObject, size)*)ptr); \
+    CONCAT3(alloc_slab, size, _wrunlock)(&alloc_slabs[i].CONCAT2(slab, size));                  \
+  }                                                                                             \
+  static size_t CONCAT2(alloc_class_size, size)(void) {                                         \
+    return CONCAT3(alloc_slab, size, _size)(&alloc_slabs[i].CONCAT2(slab, size));               \
+  }                                                                                             \
+  static void   CONCAT2(alloc_class_create, size)(void) {                                       \
+    CONCAT3(alloc_slab, size, _create)(&alloc_slabs[i].CONCAT2(slab, size));                    \
+  }                                                                                             \
+  static void   CONCAT2(alloc_class_stats, size)(AllocClassStats* out) {                        \
+    CONCAT3(AllocSlab, size, _stats) stats;                                                     \
+    CONCAT3(alloc_slab, size, _wrlock)(&alloc_slabs[i].CONCAT2(slab, size));                    \
+    CONCAT3(alloc_slab, size, _stats)(&alloc_slabs[i].CONCAT2(slab, size), &stats);             \
+    CONCAT3(alloc_slab, size, _wrunlock)(&alloc_slabs[i].CONCAT2(slab, size));                  \
+    out->blocks      = stats.blocks;                                                            \
+    out->block_bytes = stats.block_bytes;                                                       \
+    out->capacity    = stats.capacity;                                                          \
+    out->live        = stats.live;                                                              \
+    out->peak        = stats.peak;                                                              \
+    out->allocs      = stats.allocs;                                                            \
+    out->frees       = stats.frees;                                                             \
+    memcpy(out->histogram, stats.histogram, sizeof(out->histogram));                            \
+  }
+
+ALLOC_CLASSES(ALLOC_CLASS_FUNCTIONS)
+
+#define ALLOC_CLASS_ALLOC(i, size)  CONCAT2(alloc_class_alloc, size),
+#define ALLOC_CLASS_FREE(i, size)   CONCAT2(alloc_class_free, size),
+#define ALLOC_CLASS_COUNT(i, size)  CONCAT2(alloc_class_size, size),
+#define ALLOC_CLASS_CREATE(i, size) CONCAT2(alloc_class_create, size),
+#define ALLOC_CLASS_STATS(i, size)  CONCAT2(alloc_class_stats, size),
+
+static void*  (* const alloc_class_alloc [ALLOC_CLASSES_COUNT])(void)      = { ALLOC_CLASSES(ALLOC_CLASS_ALLOC) };
+static void   (* const alloc_class_free  [ALLOC_CLASSES_COUNT])(void* ptr) = { ALLOC_CLASSES(ALLOC_CLASS_FREE) };
+static size_t (* const alloc_class_count [ALLOC_CLASSES_COUNT])(void)      = { ALLOC_CLASSES(ALLOC_CLASS_COUNT) };
+static void   (* const alloc_class_create[ALLOC_CLASSES_COUNT])(void)      = { ALLOC_CLASSES(ALLOC_CLASS_CREATE) };
+static void   (* const alloc_class_stats [ALLOC_CLASSES_COUNT])(AllocClassStats* out) = { ALLOC_CLASSES(ALLOC_CLASS_STATS) };
+
+#define ALLOC_PTR_TO_BASE(ptr)  ((void**)((uintptr_t)(ptr) & ~((uintptr_t)ALLOC_BLOCK_ALIGN - 1)))
+
+static size_t blop_alloc_class(size_t size) {
+  if (size <= 16) {
+    return 0;
+  }
+  if (size <= 32) {
+    return 1;
+  }
+  /* size is in (2^high, 2^(high + 1)], the lower class of that range is 1.5 * 2^high */
+  size_t high = (size_t)(63 - blop_clz64((uint64_t)(size - 1)));
+  return 2 * (high - 5) + 2 + (size > ((size_t)3 << (high - 1)));
+}
+static size_t blop_alloc_index(void* slab) {
+  BLOP_ASSERT_FORCED((uint8_t*)slab >= (uint8_t*)alloc_slabs && (uint8_t*)slab < (uint8_t*)(alloc_slabs + ALLOC_CLASSES_COUNT), "Trying to free a foreign ptr");
+  return (size_t)((uint8_t*)slab - (uint8_t*)alloc_slabs) / sizeof(union AllocSlabs);
+}
+
+static void*  blop_alloc_large(size_t size) {
+  size_t length = sizeof(AllocLarge) + size;
+
+  #ifdef OS_POSIX
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    length = (length + page - 1) & ~(page - 1);
+
+    /* Over map by the alignment and give the unaligned head and tail back */
+    size_t   total = length + ALLOC_BLOCK_ALIGN;
+    uint8_t* base  = (uint8_t*)mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == (uint8_t*)MAP_FAILED) {
+      return NULL;
+    }
+
+    uint8_t* aligned = (uint8_t*)(((uintptr_t)base + ALLOC_BLOCK_ALIGN - 1) & ~((uintptr_t)ALLOC_BLOCK_ALIGN - 1));
+    size_t   head    = (size_t)(aligned - base);
+    size_t   tail    = total - head - length;
+    if (head) {
+      munmap(base, head);
+    }
+    if (tail) {
+      munmap(aligned + length, tail);
+    }
+    AllocLarge* large = (AllocLarge*)aligned;
+  #else
+    AllocLarge* large = (AllocLarge*)blop_aligned_alloc(ALLOC_BLOCK_ALIGN, length);
+    if (!large) {
+      return NULL;
+    }
+  #endif /* OS_POSIX */
+
+  large->hdr.slab   = NULL;
+  large->hdr.size   = size;
+  large->hdr.mapped = length;
+
+  RWLOCK_WRLOCK(alloc_large.lock);
+  alloc_large.count++;
+  alloc_large.bytes += length;
+  RWLOCK_WRUNLOCK(alloc_large.lock);
+
+  return large + 1;
+}
+static void   blop_free_large(AllocLarge* large) {
+  RWLOCK_WRLOCK(alloc_large.lock);
+  alloc_large.count--;
+  alloc_large.bytes -= large->hdr.mapped;
+  RWLOCK_WRUNLOCK(alloc_large.lock);
+
+  #ifdef OS_POSIX
+    munmap(large, large->hdr.mapped);
+  #else
+    blop_aligned_free(large);
+  #endif /* OS_POSIX */
+}
+
+/* Not thread safe, call it before starting any thread that allocates. Otherwise the first allocation calls it */
+void    blop_alloc_init(void) {
+  if (alloc_ready) {
+    return;
+  }
+
+  RWLOCK_INIT(alloc_large.lock);
+  for (size_t i = 0; i < ALLOC_CLASSES_COUNT; i++) {
+    alloc_class_create[i]();
+  }
+  alloc_ready = true;
+}
+
+void    blop_free(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+
+  void** base = ALLOC_PTR_TO_BASE(ptr);
+  if (*base == NULL) {
+    BLOP_ASSERT_FORCED(ptr == (void*)((AllocLarge*)base + 1), "Trying to free a foreign ptr");
+    blop_free_large((AllocLarge*)base);
+    return;
+  }
+
+  alloc_class_free[blop_alloc_index(*base)](ptr);
+}
+void*   blop_alloc(size_t size) {
+  if (!alloc_ready) {
+    blop_alloc_init();
+  }
+
+  if (size > ALLOC_LARGE) {
+    return blop_alloc_large(size);
+  }
+  return alloc_class_alloc[blop_alloc_class(size)]();
+}
+void*   blop_calloc(size_t count, size_t size) {
+  if (size && count > SIZE_MAX / size) {
+    return NULL;
+  }
+
+  size_t bytes = count * size;
+  void*  ptr   = blop_alloc(bytes);
+  /* Mapped memory is already zero, slab objects may hold whatever their last owner left */
+  if (ptr && bytes <= ALLOC_LARGE) {
+    memset(ptr, 0, bytes);
+  }
+  return ptr;
+}
+void*   blop_realloc(void* ptr, size_t size) {
+  if (!ptr) {
+    return blop_alloc(size);
+  }
+  if (size == 0) {
+    blop_free(ptr);
+    return NULL;
+  }
+
+  size_t usable = blop_alloc_usable(ptr);
+  /* Stay in place unless the request grew past the object or shrank to a smaller class */
+  if (size <= usable && (size > ALLOC_LARGE || blop_alloc_class(size) == blop_alloc_class(usable))) {
+    return ptr;
+  }
+
+  void* data = blop_alloc(size);
+  if (data) {
+    memcpy(data, ptr, MIN(size, usable));
+    blop_free(ptr);
+  }
+  return data;
+}
+size_t  blop_alloc_usable(void* ptr) {
+  BLOP_ASSERT_PTR(ptr);
+
+  void** base = ALLOC_PTR_TO_BASE(ptr);
+  if (*base == NULL) {
+    AllocLarge* large = (AllocLarge*)base;
+    return large->hdr.mapped - sizeof(AllocLarge);
+  }
+  return alloc_class_sizes[blop_alloc_index(*base)];
+}
+
+size_t  blop_alloc_size(void) {
+  if (!alloc_ready) {
+    return 0;
+  }
+
+  size_t count = alloc_large.count;
+  for (size_t i = 0; i < ALLOC_CLASSES_COUNT; i++) {
+    count += alloc_class_count[i]();
+  }
+  return count;
+}
+size_t  blop_alloc_bytes(void) {
+  if (!alloc_ready) {
+    return 0;
+  }
+
+  size_t bytes = alloc_large.bytes;
+  for (size_t i = 0; i < ALLOC_CLASSES_COUNT; i++) {
+    bytes += alloc_class_count[i]() * alloc_class_sizes[i];
+  }
+  return bytes;
+}
+void    blop_alloc_print_out(void) {
+  LOG_STDOUT("Alloc Information:\n Allocated objects: %zu\n Total bytes allocated: %zu\n", blop_alloc_size(), blop_alloc_bytes());
+  for (size_t i = 0; alloc_ready && i < ALLOC_CLASSES_COUNT; i++) {
+    size_t count = alloc_class_count[i]();
+    if (count) {
+      LOG_STDOUT("  Class %5zu: %zu\n", alloc_class_sizes[i], count);
+    }
+  }
+  LOG_STDOUT("  Large:       %zu (%zu bytes)\n\n", alloc_large.count, alloc_large.bytes);
+}
+void    blop_alloc_print_err(void) {
+  LOG_STDERR("Alloc Information:\n Allocated objects: %zu\n Total bytes allocated: %zu\n", blop_alloc_size(), blop_alloc_bytes());
+  for (size_t i = 0; alloc_ready && i < ALLOC_CLASSES_COUNT; i++) {
+    size_t count = alloc_class_count[i]();
+    if (count) {
+      LOG_STDERR("  Class %5zu: %zu\n", alloc_class_sizes[i], count);
+    }
+  }
+  LOG_STDERR("  Large:       %zu (%zu bytes)\n\n", alloc_large.count, alloc_large.bytes);
+}
+
+void    blop_alloc_stats(AllocStats* stats) {
+  BLOP_ASSERT_PTR(stats);
+
+  memset(stats, 0, sizeof(AllocStats));
+  for (size_t i = 0; i < ALLOC_CLASSES_COUNT; i++) {
+    stats->classes[i].size = alloc_class_sizes[i];
+    if (alloc_ready) {
+      alloc_class_stats[i](&stats->classes[i]);
+    }
+  }
+
+  if (alloc_ready) {
+    RWLOCK_RDLOCK(alloc_large.lock);
+    stats->large_count = alloc_large.count;
+    stats->large_bytes = alloc_large.bytes;
+    RWLOCK_RDUNLOCK(alloc_large.lock);
+  }
+}
+void    blop_alloc_dump_out(void) {
+  AllocStats stats;
+  blop_alloc_stats(&stats);
+
+  for (size_t i = 0; i < ALLOC_CLASSES_COUNT; i++) {
+    AllocClassStats* current = &stats.classes[i];
+    LOG_STDOUT("class=%zu blocks=%zu block_bytes=%zu capacity=%zu live=%zu peak=%zu allocs=%zu frees=%zu histogram=",
+      current->size, current->blocks, current->block_bytes, current->capacity, current->live, current->peak, current->allocs, current->frees);
+    for (size_t j = 0; j <= ALLOC_STATS_BUCKETS; j++) {
+      LOG_STDOUT("%zu%s", current->histogram[j], j < ALLOC_STATS_BUCKETS ? "," : "\n");
+    }
+  }
+  LOG_STDOUT("class=large count=%zu bytes=%zu\n", stats.large_count, stats.large_bytes);
+}
+void    blop_alloc_dump_err(void) {
+  AllocStats stats;
+  blop_alloc_stats(&stats);
+
+  for (size_t i = 0; i < ALLOC_CLASSES_COUNT; i++) {
+    AllocClassStats* current = &stats.classes[i];
+    LOG_STDERR("class=%zu blocks=%zu block_bytes=%zu capacity=%zu live=%zu peak=%zu allocs=%zu frees=%zu histogram=",
+      current->size, current->blocks, current->block_bytes, current->capacity, current->live, current->peak, current->allocs, current->frees);
+    for (size_t j = 0; j <= ALLOC_STATS_BUCKETS; j++) {
+      LOG_STDERR("%zu%s", current->histogram[j], j < ALLOC_STATS_BUCKETS ? "," : "\n");
+    }
+  }
+  LOG_STDERR("class=large count=%zu bytes=%zu\n", stats.large_count, stats.large_bytes);
+}
+
+#endif /* ALLOC_IMPLEMENTATION */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLOP_ALLOC_H__ */
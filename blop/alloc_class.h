@@ -0,0 +1,27 @@
+/* Instantiates the slab behind one blop/alloc.h size class, only meant to be included by blop/alloc.h with ALLOC_CLASS set */
+#ifndef ALLOC_CLASS
+  #error "ALLOC_CLASS must be defined before including blop/alloc_class.h"
+#endif /* ALLOC_CLASS */
+
+typedef struct CONCAT2(AllocObject, ALLOC_CLASS) {
+  uint8_t bytes[ALLOC_CLASS];
+} CONCAT2(AllocObject, ALLOC_CLASS);
+
+#define SLAB_NAME          CONCAT2(AllocSlab, ALLOC_CLASS)
+#define SLAB_FN_PREFIX     CONCAT2(alloc_slab, ALLOC_CLASS)
+#define SLAB_DATA_TYPE     CONCAT2(AllocObject, ALLOC_CLASS)
+#define SLAB_OBJECTS_COUNT ((ALLOC_BLOCK_BYTES - ALLOC_BLOCK_HEADER) / ALLOC_CLASS)
+#define SLAB_BLOCK_ALIGN   ALLOC_BLOCK_ALIGN
+/* Every block reserves ALLOC_BLOCK_ALIGN anyway, so blocks start at full size instead of growing into it */
+#define SLAB_OBJECTS_MIN   SLAB_OBJECTS_COUNT
+/* Every object is as aligned as malloc would return it */
+#define SLAB_ALIGNMENT     16
+#define SLAB_STATS
+#define SLAB_STATS_BUCKETS ALLOC_STATS_BUCKETS
+#define SLAB_STRUCT
+#ifdef ALLOC_IMPLEMENTATION
+  #define SLAB_IMPLEMENTATION
+#endif /* ALLOC_IMPLEMENTATION */
+#include <blop/slab.h>
+
+#undef ALLOC_CLASS
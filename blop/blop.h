@@ -1,6 +1,12 @@
 #ifndef __BLOP_H__
 #define __BLOP_H__
 
+/* Strict -std=c11 builds hide mmap flags, madvise, posix_memalign and the pthread rwlocks unless a feature test macro asks for them.
+ * It has to come before the first system header, so include blop.h first or define _DEFAULT_SOURCE on the command line */
+#if (defined(__unix__) || defined(__unix) || defined(__linux__) || defined(__APPLE__)) && !defined(_DEFAULT_SOURCE) && !defined(_GNU_SOURCE)
+  #define _DEFAULT_SOURCE
+#endif /* POSIX */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -90,6 +96,36 @@
   #define NORETURN _Noreturn
 #endif
 
+#if defined(__cplusplus)
+  #define THREAD_LOCAL thread_local
+#elif defined(COMPILER_MSVC)
+  #define THREAD_LOCAL __declspec(thread)
+#else
+  #define THREAD_LOCAL _Thread_local
+#endif
+
+#if defined(__cplusplus)
+  #define ALIGNAS(n) alignas(n)
+#elif defined(COMPILER_MSVC)
+  #define ALIGNAS(n) __declspec(align(n))
+#else
+  #define ALIGNAS(n) _Alignas(n)
+#endif
+
+#if defined(__cplusplus)
+  #define STATIC_ASSERT(cnd, msg) static_assert(cnd, msg)
+#else
+  #define STATIC_ASSERT(cnd, msg) _Static_assert(cnd, msg)
+#endif
+
+#ifndef CACHE_LINE_SIZE
+  #if defined(__APPLE__) && defined(__aarch64__)
+    #define CACHE_LINE_SIZE 128
+  #else
+    #define CACHE_LINE_SIZE 64
+  #endif
+#endif /* CACHE_LINE_SIZE */
+
 #if defined(__FILE_NAME__)
   #define FILE_PATH __FILE_NAME__
 #else
@@ -134,6 +170,22 @@
 #endif /* ENABLE_RWLOCK */
 //! Enable rwlocks
 
+/* --------------------------------------------------------------------------
+ * THREAD_ID
+ * -------------------------------------------------------------------------- */
+
+/* Identifies the calling thread as an uintptr_t, only meant to be compared against other THREAD_ID() values */
+#if defined(OS_WINDOWS)
+  #include <windows.h>
+  #define THREAD_ID() ((uintptr_t)GetCurrentThreadId())
+#elif defined(OS_POSIX)
+  #include <pthread.h>
+  #define THREAD_ID() ((uintptr_t)pthread_self())
+#else
+  static THREAD_LOCAL char blop_thread_tag;
+  #define THREAD_ID() ((uintptr_t)&blop_thread_tag)
+#endif /* OS_WINDOWS */
+
 /* --------------------------------------------------------------------------
  * ANSI
  * -------------------------------------------------------------------------- */
@@ -555,9 +607,9 @@ static inline NORETURN void ABORT() {
   #undef BLOP_ASSERT_PTR
   #undef BLOPF_ASSERT
 
-  #define BLOP_ASSERT(cnd, msg)           do { ((void)0) } while(0)
-  #define BLOP_ASSERT_PTR(ptr)            do { ((void)0) } while(0)
-  #define BLOPF_ASSERT(cnd, format, ...)  do { ((void)0) } while(0)
+  #define BLOP_ASSERT(cnd, msg)           do { ((void)0); } while(0)
+  #define BLOP_ASSERT_PTR(ptr)            do { ((void)0); } while(0)
+  #define BLOPF_ASSERT(cnd, format, ...)  do { ((void)0); } while(0)
 #endif /* DISABLE_BLOP_ASSERTIONS */
   
 #if defined(ASSERT_DISABLE) || defined(ASSERT_DISABLE_ALL)
@@ -643,11 +695,110 @@ static inline NORETURN void ABORT() {
 #define CONCAT2(a, b)          CONCAT2_IMPL(a, b)
 #define CONCAT3(a, b, c)       CONCAT3_IMPL(a, b, c)
 
-#define FREE(ptr)                   do { free((void*)(ptr)); (ptr) = NULL; } while(0)
+/* Every container allocates through these, define all four before including blop.h to swap the allocator (e.g. blop/alloc.h) */
+#ifndef MEM_MALLOC
+  #define MEM_MALLOC(size)          malloc((size))
+  #define MEM_CALLOC(count, size)   calloc((count), (size))
+  #define MEM_REALLOC(ptr, size)    realloc((ptr), (size))
+  #define MEM_FREE(ptr)             free((ptr))
+#endif /* MEM_MALLOC */
+
+#define FREE(ptr)                   do { MEM_FREE((void*)(ptr)); (ptr) = NULL; } while(0)
 #define FREE_IF(ptr)                do { if ((ptr)) { FREE((ptr)); } } while(0)
-#define MALLOC(v, type, size)       do { (v) = (type*)malloc((size));                ASSERT_MALLOC((v), type, (size)); memset(v, 0, (size)); } while(0)
-#define CALLOC(v, type, count)      do { (v) = (type*)calloc((count), sizeof(type)); ASSERT_CALLOC((v), type, (count));                      } while(0)
-#define REALLOC(v, type, ptr, size) do { (v) = (type*)realloc((void*)(ptr), (size)); ASSERT_REALLOC((v), type, (size));                      } while(0)
+#define MALLOC(v, type, size)       do { (v) = (type*)MEM_MALLOC((size));                ASSERT_MALLOC((v), type, (size)); memset(v, 0, (size)); } while(0)
+#define CALLOC(v, type, count)      do { (v) = (type*)MEM_CALLOC((count), sizeof(type)); ASSERT_CALLOC((v), type, (count));                      } while(0)
+#define REALLOC(v, type, ptr, size) do { (v) = (type*)MEM_REALLOC((void*)(ptr), (size)); ASSERT_REALLOC((v), type, (size));                      } while(0)
+
+#ifdef OS_WINDOWS
+  #include <malloc.h>
+#endif
+
+static inline void*  blop_aligned_alloc(size_t align, size_t size) {
+  #ifdef OS_WINDOWS
+    return _aligned_malloc(size, align);
+  #else
+    void* ptr = NULL;
+    if (posix_memalign(&ptr, align, size) != 0) {
+      return NULL;
+    }
+    return ptr;
+  #endif
+}
+static inline void   blop_aligned_free (void* ptr) {
+  #ifdef OS_WINDOWS
+    _aligned_free(ptr);
+  #else
+    free(ptr);
+  #endif
+}
+/* Constant expression twin of blop_next_pow2 for compile time sizes (n must be at least 1) */
+#define BLOP_POW2_SMEAR(n, shift) ((n) | ((n) >> (shift)))
+#define BLOP_NEXT_POW2(n)         ((size_t)(BLOP_POW2_SMEAR(BLOP_POW2_SMEAR(BLOP_POW2_SMEAR(BLOP_POW2_SMEAR(BLOP_POW2_SMEAR(BLOP_POW2_SMEAR((uint64_t)(n) - 1, 1), 2), 4), 8), 16), 32) + 1))
+
+static inline size_t blop_next_pow2    (size_t n) {
+  size_t pow2 = 1;
+  while (pow2 < n) {
+    pow2 <<= 1;
+  }
+  return pow2;
+}
+static inline int    blop_ctz64        (uint64_t n) {
+  #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    return __builtin_ctzll(n);
+  #else
+    int count = 0;
+    while (!(n & 1) && count < 64) {
+      n >>= 1;
+      count++;
+    }
+    return count;
+  #endif
+}
+
+static inline int    blop_clz64        (uint64_t n) {
+  #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    return __builtin_clzll(n);
+  #else
+    int count = 0;
+    while (!(n & ((uint64_t)1 << 63)) && count < 64) {
+      n <<= 1;
+      count++;
+    }
+    return count;
+  #endif
+}
+
+static inline int    blop_popcount64   (uint64_t n) {
+  #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    return __builtin_popcountll(n);
+  #else
+    int count = 0;
+    while (n) {
+      n &= n - 1;
+      count++;
+    }
+    return count;
+  #endif
+}
+
+/* Radix sort keys, unsigned integers whose order matches the order of the signed or float value. Unsigned values are keys as they are */
+static inline uint32_t blop_radix_i32   (int32_t value) {
+  return (uint32_t)value ^ ((uint32_t)1 << 31);
+}
+static inline uint64_t blop_radix_i64   (int64_t value) {
+  return (uint64_t)value ^ ((uint64_t)1 << 63);
+}
+/* Negative floats have every bit flipped so larger magnitudes sort first, positive ones only the sign. NaNs sort to the ends */
+static inline uint32_t blop_radix_f32   (float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits ^ (uint32_t)(-(int32_t)(bits >> 31) | ((uint32_t)1 << 31));
+}
+static inline uint64_t blop_radix_f64   (double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits ^ (uint64_t)(-(int64_t)(bits >> 63) | ((uint64_t)1 << 63));
+}
 
 #define CAST(type, tocast) ((type)(tocast))
 #define TERNARY(cnd, x, y) ((cnd) ? (x) : (y))
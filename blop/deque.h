@@ -0,0 +1,351 @@
+#include <blop/blop.h>
+
+#ifndef DEQUE_NAME
+  #define DEQUE_NAME Dequeint
+#endif /* DEQUE_NAME */
+
+#ifndef DEQUE_FN_PREFIX
+  #define DEQUE_FN_PREFIX DEQUE_NAME
+#endif /* DEQUE_FN_PREFIX */
+
+#ifndef DEQUE_DATA_TYPE
+  #define DEQUE_DATA_TYPE int
+#endif /* DEQUE_DATA_TYPE */
+
+/* Must be a power of two, the capacity always stays one so wrapping an index is a mask */
+#if !defined(DEQUE_INITIAL_SIZE) || DEQUE_INITIAL_SIZE <= 0
+  #define DEQUE_INITIAL_SIZE 16
+#endif /* DEQUE_INITIAL_SIZE */
+
+#if (DEQUE_INITIAL_SIZE & (DEQUE_INITIAL_SIZE - 1)) != 0
+  #error "DEQUE_INITIAL_SIZE must be a power of two"
+#endif
+
+#define DEQUE_WRAP(deque, idx) ((idx) & ((deque)->capacity - 1))
+
+/** @cond doxygen_ignore */
+#define struct_deque          DEQUE_NAME
+
+#define fn_deque_create       CONCAT2(DEQUE_FN_PREFIX, _create)
+#define fn_deque_destroy      CONCAT2(DEQUE_FN_PREFIX, _destroy)
+
+#define fn_deque_rdlock       CONCAT2(DEQUE_FN_PREFIX, _rdlock)
+#define fn_deque_wrlock       CONCAT2(DEQUE_FN_PREFIX, _wrlock)
+#define fn_deque_rdunlock     CONCAT2(DEQUE_FN_PREFIX, _rdunlock)
+#define fn_deque_wrunlock     CONCAT2(DEQUE_FN_PREFIX, _wrunlock)
+
+#define fn_deque_size         CONCAT2(DEQUE_FN_PREFIX, _size)
+#define fn_deque_back         CONCAT2(DEQUE_FN_PREFIX, _back)
+#define fn_deque_front        CONCAT2(DEQUE_FN_PREFIX, _front)
+#define fn_deque_spans        CONCAT2(DEQUE_FN_PREFIX, _spans)
+
+#define fn_deque_set          CONCAT2(DEQUE_FN_PREFIX, _set)
+#define fn_deque_get          CONCAT2(DEQUE_FN_PREFIX, _get)
+#define fn_deque_grow         CONCAT2(DEQUE_FN_PREFIX, _grow)
+#define fn_deque_reserve      CONCAT2(DEQUE_FN_PREFIX, _reserve)
+
+#define fn_deque_clear        CONCAT2(DEQUE_FN_PREFIX, _clear)
+#define fn_deque_pop_back     CONCAT2(DEQUE_FN_PREFIX, _pop_back)
+#define fn_deque_pop_front    CONCAT2(DEQUE_FN_PREFIX, _pop_front)
+
+#define fn_deque_push_back    CONCAT2(DEQUE_FN_PREFIX, _push_back)
+#define fn_deque_push_front   CONCAT2(DEQUE_FN_PREFIX, _push_front)
+
+#define fn_deque_write        CONCAT2(DEQUE_FN_PREFIX, _write)
+#define fn_deque_read         CONCAT2(DEQUE_FN_PREFIX, _read)
+/** @endcond */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct struct_deque;
+typedef struct struct_deque struct_deque;
+
+struct_deque*     fn_deque_create     (struct_deque* deque);
+void              fn_deque_destroy    (struct_deque* deque);
+
+void              fn_deque_rdlock     (struct_deque* deque);
+void              fn_deque_wrlock     (struct_deque* deque);
+void              fn_deque_rdunlock   (struct_deque* deque);
+void              fn_deque_wrunlock   (struct_deque* deque);
+
+size_t            fn_deque_size       (struct_deque* deque);
+DEQUE_DATA_TYPE   fn_deque_back       (struct_deque* deque);
+DEQUE_DATA_TYPE   fn_deque_front      (struct_deque* deque);
+size_t            fn_deque_spans      (struct_deque* deque, DEQUE_DATA_TYPE** first, DEQUE_DATA_TYPE** second, size_t* second_count);
+
+void              fn_deque_set        (struct_deque* deque, size_t idx, DEQUE_DATA_TYPE value);
+DEQUE_DATA_TYPE   fn_deque_get        (struct_deque* deque, size_t idx);
+void              fn_deque_reserve    (struct_deque* deque, size_t capacity);
+
+void              fn_deque_clear      (struct_deque* deque);
+void              fn_deque_pop_back   (struct_deque* deque);
+void              fn_deque_pop_front  (struct_deque* deque);
+
+void              fn_deque_push_back  (struct_deque* deque, DEQUE_DATA_TYPE value);
+void              fn_deque_push_front (struct_deque* deque, DEQUE_DATA_TYPE value);
+
+void              fn_deque_write      (struct_deque* deque, const DEQUE_DATA_TYPE* src, size_t count);
+size_t            fn_deque_read       (struct_deque* deque,       DEQUE_DATA_TYPE* dst, size_t count);
+
+/* Elements live in data[head, head + size) wrapped around capacity, so they take at most two contiguous spans */
+#ifdef DEQUE_STRUCT
+  struct struct_deque {
+    DEQUE_DATA_TYPE*  data;
+    size_t            head;
+    size_t            size;
+    size_t            capacity;
+    int               allocated;
+    RWLOCK_TYPE       lock;
+  };
+#endif /* DEQUE_STRUCT */
+
+#ifdef DEQUE_IMPLEMENTATION
+
+static void       fn_deque_grow(struct_deque* deque, size_t capacity) {
+  size_t old = deque->capacity;
+  REALLOC(deque->data, DEQUE_DATA_TYPE, deque->data, capacity * sizeof(DEQUE_DATA_TYPE));
+  deque->capacity = capacity;
+
+  /* The wrapped part moves right after the old end, which keeps the elements in order without touching the rest */
+  if (deque->head + deque->size > old) {
+    memcpy(&deque->data[old], deque->data, (deque->head + deque->size - old) * sizeof(DEQUE_DATA_TYPE));
+  }
+}
+
+struct_deque*     fn_deque_create(struct_deque* deque) {
+  if (!deque) {
+    CALLOC(deque, struct struct_deque, 1);
+    deque->allocated = true;
+  } else {
+    deque->allocated = false;
+  }
+
+  deque->data     = NULL;
+  deque->head     = 0;
+  deque->size     = 0;
+  deque->capacity = 0;
+  fn_deque_grow(deque, DEQUE_INITIAL_SIZE);
+  RWLOCK_INIT(deque->lock);
+
+  return deque;
+}
+void              fn_deque_destroy(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+
+  BLOP_ASSERT(deque->size == 0, "Destroying non empty deque (HINT: Clear the deque)");
+
+  RWLOCK_DESTROY(deque->lock);
+  FREE(deque->data);
+
+  if (deque->allocated) {
+    FREE(deque);
+  }
+}
+
+void              fn_deque_rdlock(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+  RWLOCK_RDLOCK(deque->lock);
+}
+void              fn_deque_wrlock(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+  RWLOCK_WRLOCK(deque->lock);
+}
+void              fn_deque_rdunlock(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+  RWLOCK_RDUNLOCK(deque->lock);
+}
+void              fn_deque_wrunlock(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+  RWLOCK_WRUNLOCK(deque->lock);
+}
+
+size_t            fn_deque_size(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+  return deque->size;
+}
+DEQUE_DATA_TYPE   fn_deque_back(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+
+  BLOP_ASSERT_FORCED(deque->size != 0, "Deque has no back (size == 0)");
+  return deque->data[DEQUE_WRAP(deque, deque->head + deque->size - 1)];
+}
+DEQUE_DATA_TYPE   fn_deque_front(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+
+  BLOP_ASSERT_FORCED(deque->size != 0, "Deque has no front (size == 0)");
+  return deque->data[deque->head];
+}
+size_t            fn_deque_spans(struct_deque* deque, DEQUE_DATA_TYPE** first, DEQUE_DATA_TYPE** second, size_t* second_count) {
+  BLOP_ASSERT_PTR(deque);
+  BLOP_ASSERT_PTR(first);
+  BLOP_ASSERT_PTR(second);
+  BLOP_ASSERT_PTR(second_count);
+
+  /* Returns how many elements the first span holds, the second one (possibly empty) continues it from data[0] */
+  size_t count  = MIN(deque->size, deque->capacity - deque->head);
+  *first        = &deque->data[deque->head];
+  *second       = deque->data;
+  *second_count = deque->size - count;
+  return count;
+}
+
+void              fn_deque_set(struct_deque* deque, size_t idx, DEQUE_DATA_TYPE value) {
+  BLOP_ASSERT_PTR(deque);
+
+  BLOP_ASSERT_BOUNDS(idx, deque->size);
+  deque->data[DEQUE_WRAP(deque, deque->head + idx)] = value;
+}
+DEQUE_DATA_TYPE   fn_deque_get(struct_deque* deque, size_t idx) {
+  BLOP_ASSERT_PTR(deque);
+
+  BLOP_ASSERT_BOUNDS(idx, deque->size);
+  return deque->data[DEQUE_WRAP(deque, deque->head + idx)];
+}
+void              fn_deque_reserve(struct_deque* deque, size_t capacity) {
+  BLOP_ASSERT_PTR(deque);
+
+  if (capacity > deque->capacity) {
+    fn_deque_grow(deque, blop_next_pow2(capacity));
+  }
+}
+
+void              fn_deque_clear(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+
+  #ifdef DEQUE_DEALLOCATE_DATA
+    for (size_t i = 0; i < deque->size; i++) {
+      DEQUE_DEALLOCATE_DATA(deque->data[DEQUE_WRAP(deque, deque->head + i)]);
+    }
+  #endif /* DEQUE_DEALLOCATE_DATA */
+
+  deque->head = 0;
+  deque->size = 0;
+}
+void              fn_deque_pop_back(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+
+  if (deque->size == 0) {
+    EMPTY_POPPING();
+    return;
+  }
+
+  #ifdef DEQUE_DEALLOCATE_DATA
+    DEQUE_DEALLOCATE_DATA(deque->data[DEQUE_WRAP(deque, deque->head + deque->size - 1)]);
+  #endif /* DEQUE_DEALLOCATE_DATA */
+
+  deque->size--;
+}
+void              fn_deque_pop_front(struct_deque* deque) {
+  BLOP_ASSERT_PTR(deque);
+
+  if (deque->size == 0) {
+    EMPTY_POPPING();
+    return;
+  }
+
+  #ifdef DEQUE_DEALLOCATE_DATA
+    DEQUE_DEALLOCATE_DATA(deque->data[deque->head]);
+  #endif /* DEQUE_DEALLOCATE_DATA */
+
+  deque->head = DEQUE_WRAP(deque, deque->head + 1);
+  deque->size--;
+}
+
+void              fn_deque_push_back(struct_deque* deque, DEQUE_DATA_TYPE value) {
+  BLOP_ASSERT_PTR(deque);
+
+  if (deque->size == deque->capacity) {
+    fn_deque_grow(deque, deque->capacity * 2);
+  }
+
+  deque->data[DEQUE_WRAP(deque, deque->head + deque->size)] = value;
+  deque->size++;
+}
+void              fn_deque_push_front(struct_deque* deque, DEQUE_DATA_TYPE value) {
+  BLOP_ASSERT_PTR(deque);
+
+  if (deque->size == deque->capacity) {
+    fn_deque_grow(deque, deque->capacity * 2);
+  }
+
+  deque->head = DEQUE_WRAP(deque, deque->head + deque->capacity - 1);
+  deque->data[deque->head] = value;
+  deque->size++;
+}
+
+void              fn_deque_write(struct_deque* deque, const DEQUE_DATA_TYPE* src, size_t count) {
+  BLOP_ASSERT_PTR(deque);
+  BLOP_ASSERT_PTR(src);
+
+  /* Appends at the back with at most one growth and two memcpy, one per span of free space */
+  fn_deque_reserve(deque, deque->size + count);
+
+  size_t tail  = DEQUE_WRAP(deque, deque->head + deque->size);
+  size_t first = MIN(count, deque->capacity - tail);
+  memcpy(&deque->data[tail], src, first * sizeof(DEQUE_DATA_TYPE));
+  memcpy(deque->data, &src[first], (count - first) * sizeof(DEQUE_DATA_TYPE));
+  deque->size += count;
+}
+size_t            fn_deque_read(struct_deque* deque, DEQUE_DATA_TYPE* dst, size_t count) {
+  BLOP_ASSERT_PTR(deque);
+  BLOP_ASSERT_PTR(dst);
+
+  /* Moves up to count elements from the front into dst and returns how many were moved */
+  count = MIN(count, deque->size);
+  size_t first = MIN(count, deque->capacity - deque->head);
+  memcpy(dst, &deque->data[deque->head], first * sizeof(DEQUE_DATA_TYPE));
+  memcpy(&dst[first], deque->data, (count - first) * sizeof(DEQUE_DATA_TYPE));
+
+  deque->head  = DEQUE_WRAP(deque, deque->head + count);
+  deque->size -= count;
+  return count;
+}
+
+#endif /* DEQUE_IMPLEMENTATION */
+
+#ifdef __cplusplus
+}
+#endif
+
+#undef DEQUE_NAME
+#undef DEQUE_FN_PREFIX
+
+#undef DEQUE_DATA_TYPE
+#undef DEQUE_INITIAL_SIZE
+#undef DEQUE_DEALLOCATE_DATA
+#undef DEQUE_WRAP
+
+#undef DEQUE_STRUCT
+#undef DEQUE_IMPLEMENTATION
+
+#undef struct_deque
+
+#undef fn_deque_create
+#undef fn_deque_destroy
+
+#undef fn_deque_rdlock
+#undef fn_deque_wrlock
+#undef fn_deque_rdunlock
+#undef fn_deque_wrunlock
+
+#undef fn_deque_size
+#undef fn_deque_back
+#undef fn_deque_front
+#undef fn_deque_spans
+
+#undef fn_deque_set
+#undef fn_deque_get
+#undef fn_deque_grow
+#undef fn_deque_reserve
+
+#undef fn_deque_clear
+#undef fn_deque_pop_back
+#undef fn_deque_pop_front
+
+#undef fn_deque_push_back
+#undef fn_deque_push_front
+
+#undef fn_deque_write
+#undef fn_deque_read
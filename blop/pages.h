@@ -0,0 +1,253 @@
+#include <stddef.h>
+#include <blop/blop.h>
+
+#ifndef PAGES_NAME
+  #define PAGES_NAME Pages
+#endif /* PAGES_NAME */
+
+#ifndef PAGES_FN_PREFIX
+  #define PAGES_FN_PREFIX PAGES_NAME
+#endif /* PAGES_FN_PREFIX */
+
+/* Bytes mapped from the OS at a time, blocks are carved out of these chunks */
+#ifndef PAGES_CHUNK_SIZE
+  #define PAGES_CHUNK_SIZE ((size_t)4 << 20)
+#endif /* PAGES_CHUNK_SIZE */
+
+/* Chunks at least this big are aligned to it and advised as transparent huge pages */
+#ifndef PAGES_HUGEPAGE_SIZE
+  #define PAGES_HUGEPAGE_SIZE ((size_t)2 << 20)
+#endif /* PAGES_HUGEPAGE_SIZE */
+
+#ifdef OS_POSIX
+  #include <unistd.h>
+  #include <sys/mman.h>
+#endif /* OS_POSIX */
+
+#define struct_pages          PAGES_NAME
+
+#define fn_pages_create       CONCAT2(PAGES_FN_PREFIX, _create)
+#define fn_pages_destroy      CONCAT2(PAGES_FN_PREFIX, _destroy)
+#define fn_pages_chunk        CONCAT2(PAGES_FN_PREFIX, _chunk)
+
+#define fn_pages_free         CONCAT2(PAGES_FN_PREFIX, _free)
+#define fn_pages_alloc        CONCAT2(PAGES_FN_PREFIX, _alloc)
+
+#define fn_pages_bytes        CONCAT2(PAGES_FN_PREFIX, _bytes)
+#define fn_pages_print_out    CONCAT2(PAGES_FN_PREFIX, _print_out)
+#define fn_pages_print_err    CONCAT2(PAGES_FN_PREFIX, _print_err)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct struct_pages;
+typedef struct struct_pages struct_pages;
+
+struct_pages*     fn_pages_create       (struct_pages* pages);
+void              fn_pages_destroy      (struct_pages* pages);
+
+void              fn_pages_free         (struct_pages* pages, void* ptr, size_t size);
+void*             fn_pages_alloc        (struct_pages* pages, size_t size, size_t align);
+
+size_t            fn_pages_bytes        (struct_pages* pages);
+void              fn_pages_print_out    (struct_pages* pages);
+void              fn_pages_print_err    (struct_pages* pages);
+
+#ifdef PAGES_STRUCT
+/* Every block has the same stride, fixed by the first alloc. Released blocks keep their first page resident to link them */
+struct struct_pages {
+  RWLOCK_TYPE       lock;
+  size_t            page;
+  size_t            stride;
+  uint8_t*          cursor;
+  uint8_t*          end;
+  void*             released;
+  void**            chunks;
+  size_t            chunks_count;
+  size_t            chunk_size;
+  size_t            live;
+  int               allocated;
+};
+#endif /* PAGES_STRUCT */
+
+#ifdef PAGES_IMPLEMENTATION
+
+struct_pages*     fn_pages_create(struct_pages* pages) {
+  if (!pages) {
+    CALLOC(pages, struct struct_pages, 1);
+    pages->allocated = true;
+  } else {
+    pages->allocated = false;
+  }
+
+  RWLOCK_INIT(pages->lock);
+
+  #ifdef OS_POSIX
+    pages->page = (size_t)sysconf(_SC_PAGESIZE);
+  #else
+    pages->page = 4096;
+  #endif /* OS_POSIX */
+
+  pages->stride       = 0;
+  pages->cursor       = NULL;
+  pages->end          = NULL;
+  pages->released     = NULL;
+  pages->chunks       = NULL;
+  pages->chunks_count = 0;
+  pages->chunk_size   = 0;
+  pages->live         = 0;
+
+  return pages;
+}
+void              fn_pages_destroy(struct_pages* pages) {
+  BLOP_ASSERT_PTR(pages);
+
+  BLOP_ASSERT(pages->live == 0, "Destroying pages with blocks still in use (HINT: Destroy the slabs first)");
+
+  for (size_t i = 0; i < pages->chunks_count; i++) {
+    #ifdef OS_POSIX
+      munmap(pages->chunks[i], pages->chunk_size);
+    #else
+      blop_aligned_free(pages->chunks[i]);
+    #endif /* OS_POSIX */
+  }
+  FREE_IF(pages->chunks);
+
+  RWLOCK_DESTROY(pages->lock);
+  if (pages->allocated) {
+    FREE(pages);
+  }
+}
+static void       fn_pages_chunk(struct_pages* pages, size_t align) {
+  void* chunk = NULL;
+
+  #ifdef OS_POSIX
+    /* Over map by the alignment and give the unaligned head and tail back */
+    size_t   length = pages->chunk_size + align;
+    uint8_t* base   = (uint8_t*)mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    BLOP_ASSERT_FORCED(base != (uint8_t*)MAP_FAILED, "Failed to map a pages chunk (mmap)");
+
+    uint8_t* aligned = (uint8_t*)(((uintptr_t)base + align - 1) & ~((uintptr_t)align - 1));
+    size_t   head    = (size_t)(aligned - base);
+    size_t   tail    = length - head - pages->chunk_size;
+    if (head) {
+      munmap(base, head);
+    }
+    if (tail) {
+      munmap(aligned + pages->chunk_size, tail);
+    }
+
+    #ifdef MADV_HUGEPAGE
+      if (pages->chunk_size >= PAGES_HUGEPAGE_SIZE) {
+        madvise(aligned, pages->chunk_size, MADV_HUGEPAGE);
+      }
+    #endif /* MADV_HUGEPAGE */
+
+    chunk = aligned;
+  #else
+    chunk = blop_aligned_alloc(align, pages->chunk_size);
+    BLOP_ASSERT_FORCED(chunk, "Failed to allocate a pages chunk");
+  #endif /* OS_POSIX */
+
+  void** chunks = NULL;
+  REALLOC(chunks, void*, pages->chunks, (pages->chunks_count + 1) * sizeof(void*));
+  chunks[pages->chunks_count++] = chunk;
+  pages->chunks = chunks;
+
+  pages->cursor = (uint8_t*)chunk;
+  pages->end    = (uint8_t*)chunk + pages->chunk_size;
+}
+
+void              fn_pages_free(struct_pages* pages, void* ptr, size_t size) {
+  BLOP_ASSERT_PTR(pages);
+  BLOP_ASSERT_PTR(ptr);
+  (void)size;
+
+  RWLOCK_WRLOCK(pages->lock);
+
+  #if defined(OS_POSIX) && defined(MADV_DONTNEED)
+    if (pages->stride > pages->page) {
+      madvise((uint8_t*)ptr + pages->page, pages->stride - pages->page, MADV_DONTNEED);
+    }
+  #endif /* OS_POSIX && MADV_DONTNEED */
+
+  *(void**)ptr    = pages->released;
+  pages->released = ptr;
+  pages->live--;
+
+  RWLOCK_WRUNLOCK(pages->lock);
+}
+void*             fn_pages_alloc(struct_pages* pages, size_t size, size_t align) {
+  BLOP_ASSERT_PTR(pages);
+  BLOP_ASSERT_FORCED(align && (align & (align - 1)) == 0, "Pages alignment must be a power of two");
+
+  RWLOCK_WRLOCK(pages->lock);
+
+  size_t stride = (size + align - 1) & ~(align - 1);
+  if (!pages->stride) {
+    pages->stride     = stride;
+    pages->chunk_size = (MAX(PAGES_CHUNK_SIZE, stride) + stride - 1) / stride * stride;
+  }
+  BLOP_ASSERT_FORCED(stride == pages->stride, "Every block taken from the same pages must have the same size and alignment");
+
+  void* ptr = pages->released;
+  if (ptr) {
+    pages->released = *(void**)ptr;
+  } else {
+    if (pages->cursor == pages->end) {
+      size_t chunk_align = align;
+      if (pages->chunk_size >= PAGES_HUGEPAGE_SIZE) {
+        chunk_align = MAX(align, PAGES_HUGEPAGE_SIZE);
+      }
+      fn_pages_chunk(pages, chunk_align);
+    }
+    ptr = pages->cursor;
+    pages->cursor += pages->stride;
+  }
+  pages->live++;
+
+  RWLOCK_WRUNLOCK(pages->lock);
+  return ptr;
+}
+
+size_t            fn_pages_bytes(struct_pages* pages) {
+  BLOP_ASSERT_PTR(pages);
+  return pages->chunks_count * pages->chunk_size;
+}
+void              fn_pages_print_out(struct_pages* pages) {
+  BLOP_ASSERT_PTR(pages);
+  LOG_STDOUT("Pages Information:\n Block stride: %zu\n Blocks in use: %zu\n Chunks mapped: %zu\n Total bytes mapped: %zu\n\n", pages->stride, pages->live, pages->chunks_count, fn_pages_bytes(pages));
+}
+void              fn_pages_print_err(struct_pages* pages) {
+  BLOP_ASSERT_PTR(pages);
+  LOG_STDERR("Pages Information:\n Block stride: %zu\n Blocks in use: %zu\n Chunks mapped: %zu\n Total bytes mapped: %zu\n\n", pages->stride, pages->live, pages->chunks_count, fn_pages_bytes(pages));
+}
+
+#endif /* PAGES_IMPLEMENTATION */
+
+#ifdef __cplusplus
+}
+#endif
+
+#undef PAGES_NAME
+#undef PAGES_FN_PREFIX
+
+#undef PAGES_CHUNK_SIZE
+#undef PAGES_HUGEPAGE_SIZE
+
+#undef PAGES_STRUCT
+#undef PAGES_IMPLEMENTATION
+
+#undef struct_pages
+
+#undef fn_pages_create
+#undef fn_pages_destroy
+#undef fn_pages_chunk
+
+#undef fn_pages_free
+#undef fn_pages_alloc
+
+#undef fn_pages_bytes
+#undef fn_pages_print_out
+#undef fn_pages_print_err
@@ -0,0 +1,471 @@
+#ifndef __BLOP_SIMD_H__
+#define __BLOP_SIMD_H__
+
+#include <blop/blop.h>
+
+/* Widest instruction set enabled by the compiler flags (-mavx2, /arch:AVX2, ...), DISABLE_BLOP_SIMD forces the scalar loops */
+#if !defined(DISABLE_BLOP_SIMD) && defined(__AVX2__)
+  #define BLOP_SIMD_AVX2
+#elif !defined(DISABLE_BLOP_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define BLOP_SIMD_SSE2
+#elif !defined(DISABLE_BLOP_SIMD) && (defined(__ARM_NEON) && defined(__aarch64__) || defined(_M_ARM64))
+  #define BLOP_SIMD_NEON
+#endif
+
+/* Every kernel takes a plain array, vectors of BLOP_SIMD_LANES 32 bit lanes are processed with unaligned loads and the tail is scalar */
+#if defined(BLOP_SIMD_AVX2)
+  #include <immintrin.h>
+
+  #define BLOP_SIMD
+  #define BLOP_SIMD_LANES 8
+
+  typedef __m256i blop_simd_i32v;
+  typedef __m256  blop_simd_f32v;
+  typedef __m256i blop_simd_i64v;
+  typedef __m256i blop_simd_mask;
+
+  #define BLOP_SIMD_I32_LOAD(ptr)        _mm256_loadu_si256((const __m256i*)(ptr))
+  #define BLOP_SIMD_I32_STORE(ptr, v)    _mm256_storeu_si256((__m256i*)(ptr), (v))
+  #define BLOP_SIMD_I32_SET1(x)          _mm256_set1_epi32(x)
+  #define BLOP_SIMD_I32_EQ(a, b)         _mm256_cmpeq_epi32((a), (b))
+  #define BLOP_SIMD_I32_MIN(a, b)        _mm256_min_epi32((a), (b))
+  #define BLOP_SIMD_I32_MAX(a, b)        _mm256_max_epi32((a), (b))
+
+  #define BLOP_SIMD_F32_LOAD(ptr)        _mm256_loadu_ps(ptr)
+  #define BLOP_SIMD_F32_STORE(ptr, v)    _mm256_storeu_ps((ptr), (v))
+  #define BLOP_SIMD_F32_SET1(x)          _mm256_set1_ps(x)
+  #define BLOP_SIMD_F32_ZERO()           _mm256_setzero_ps()
+  #define BLOP_SIMD_F32_EQ(a, b)         _mm256_castps_si256(_mm256_cmp_ps((a), (b), _CMP_EQ_OQ))
+  #define BLOP_SIMD_F32_ADD(a, b)        _mm256_add_ps((a), (b))
+  #define BLOP_SIMD_F32_MUL(a, b)        _mm256_mul_ps((a), (b))
+  #define BLOP_SIMD_F32_MIN(a, b)        _mm256_min_ps((a), (b))
+  #define BLOP_SIMD_F32_MAX(a, b)        _mm256_max_ps((a), (b))
+
+  #define BLOP_SIMD_I64_ZERO()           _mm256_setzero_si256()
+  #define BLOP_SIMD_I64_STORE(ptr, v)    _mm256_storeu_si256((__m256i*)(ptr), (v))
+
+  #define BLOP_SIMD_MASK_ZERO()          _mm256_setzero_si256()
+  #define BLOP_SIMD_MASK_OR(a, b)        _mm256_or_si256((a), (b))
+  #define BLOP_SIMD_MASK_ANY(m)          (!_mm256_testz_si256((m), (m)))
+  #define BLOP_SIMD_MASK_COUNT(cnt, m)   _mm256_sub_epi32((cnt), (m))
+  #define BLOP_SIMD_MASK_STORE(ptr, m)   _mm256_storeu_si256((__m256i*)(ptr), (m))
+
+  /* Sign extends the 32 bit lanes and adds them to the 64 bit accumulator */
+  static inline blop_simd_i64v blop_simd_widen_add(blop_simd_i64v acc, blop_simd_i32v x) {
+    __m256i lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x));
+    __m256i hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1));
+    return _mm256_add_epi64(acc, _mm256_add_epi64(lo, hi));
+  }
+  /* Adds the full 64 bit products a * b to the 64 bit accumulator, even lanes first then odd lanes */
+  static inline blop_simd_i64v blop_simd_widen_madd(blop_simd_i64v acc, blop_simd_i32v a, blop_simd_i32v b) {
+    __m256i even = _mm256_mul_epi32(a, b);
+    __m256i odd  = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_add_epi64(acc, _mm256_add_epi64(even, odd));
+  }
+#elif defined(BLOP_SIMD_SSE2)
+  #include <emmintrin.h>
+
+  #define BLOP_SIMD
+  #define BLOP_SIMD_LANES 4
+
+  typedef __m128i blop_simd_i32v;
+  typedef __m128  blop_simd_f32v;
+  typedef __m128i blop_simd_i64v;
+  typedef __m128i blop_simd_mask;
+
+  #define BLOP_SIMD_I32_LOAD(ptr)        _mm_loadu_si128((const __m128i*)(ptr))
+  #define BLOP_SIMD_I32_STORE(ptr, v)    _mm_storeu_si128((__m128i*)(ptr), (v))
+  #define BLOP_SIMD_I32_SET1(x)          _mm_set1_epi32(x)
+  #define BLOP_SIMD_I32_EQ(a, b)         _mm_cmpeq_epi32((a), (b))
+  #define BLOP_SIMD_I32_MIN(a, b)        blop_simd_select((a), (b), _mm_cmpgt_epi32((a), (b)))
+  #define BLOP_SIMD_I32_MAX(a, b)        blop_simd_select((a), (b), _mm_cmplt_epi32((a), (b)))
+
+  #define BLOP_SIMD_F32_LOAD(ptr)        _mm_loadu_ps(ptr)
+  #define BLOP_SIMD_F32_STORE(ptr, v)    _mm_storeu_ps((ptr), (v))
+  #define BLOP_SIMD_F32_SET1(x)          _mm_set1_ps(x)
+  #define BLOP_SIMD_F32_ZERO()           _mm_setzero_ps()
+  #define BLOP_SIMD_F32_EQ(a, b)         _mm_castps_si128(_mm_cmpeq_ps((a), (b)))
+  #define BLOP_SIMD_F32_ADD(a, b)        _mm_add_ps((a), (b))
+  #define BLOP_SIMD_F32_MUL(a, b)        _mm_mul_ps((a), (b))
+  #define BLOP_SIMD_F32_MIN(a, b)        _mm_min_ps((a), (b))
+  #define BLOP_SIMD_F32_MAX(a, b)        _mm_max_ps((a), (b))
+
+  #define BLOP_SIMD_I64_ZERO()           _mm_setzero_si128()
+  #define BLOP_SIMD_I64_STORE(ptr, v)    _mm_storeu_si128((__m128i*)(ptr), (v))
+
+  #define BLOP_SIMD_MASK_ZERO()          _mm_setzero_si128()
+  #define BLOP_SIMD_MASK_OR(a, b)        _mm_or_si128((a), (b))
+  #define BLOP_SIMD_MASK_ANY(m)          (_mm_movemask_epi8(m) != 0)
+  #define BLOP_SIMD_MASK_COUNT(cnt, m)   _mm_sub_epi32((cnt), (m))
+  #define BLOP_SIMD_MASK_STORE(ptr, m)   _mm_storeu_si128((__m128i*)(ptr), (m))
+
+  /* SSE2 has no pminsd/pmaxsd, lanes of a where the mask is set are replaced by b */
+  static inline blop_simd_i32v blop_simd_select(blop_simd_i32v a, blop_simd_i32v b, blop_simd_mask m) {
+    return _mm_or_si128(_mm_and_si128(m, b), _mm_andnot_si128(m, a));
+  }
+  static inline blop_simd_i64v blop_simd_widen_add(blop_simd_i64v acc, blop_simd_i32v x) {
+    __m128i sign = _mm_srai_epi32(x, 31);
+    __m128i lo   = _mm_unpacklo_epi32(x, sign);
+    __m128i hi   = _mm_unpackhi_epi32(x, sign);
+    return _mm_add_epi64(acc, _mm_add_epi64(lo, hi));
+  }
+  /* SSE2 only multiplies unsigned, the signed product is fixed up by subtracting (a < 0 ? b : 0) + (b < 0 ? a : 0) from its high half */
+  static inline __m128i        blop_simd_mul_even(__m128i a, __m128i b) {
+    __m128i fix = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b), _mm_and_si128(_mm_srai_epi32(b, 31), a));
+    return _mm_sub_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(fix, 32));
+  }
+  static inline blop_simd_i64v blop_simd_widen_madd(blop_simd_i64v acc, blop_simd_i32v a, blop_simd_i32v b) {
+    __m128i even = blop_simd_mul_even(a, b);
+    __m128i odd  = blop_simd_mul_even(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_add_epi64(acc, _mm_add_epi64(even, odd));
+  }
+#elif defined(BLOP_SIMD_NEON)
+  #include <arm_neon.h>
+
+  #define BLOP_SIMD
+  #define BLOP_SIMD_LANES 4
+
+  typedef int32x4_t   blop_simd_i32v;
+  typedef float32x4_t blop_simd_f32v;
+  typedef int64x2_t   blop_simd_i64v;
+  typedef uint32x4_t  blop_simd_mask;
+
+  #define BLOP_SIMD_I32_LOAD(ptr)        vld1q_s32(ptr)
+  #define BLOP_SIMD_I32_STORE(ptr, v)    vst1q_s32((ptr), (v))
+  #define BLOP_SIMD_I32_SET1(x)          vdupq_n_s32(x)
+  #define BLOP_SIMD_I32_EQ(a, b)         vceqq_s32((a), (b))
+  #define BLOP_SIMD_I32_MIN(a, b)        vminq_s32((a), (b))
+  #define BLOP_SIMD_I32_MAX(a, b)        vmaxq_s32((a), (b))
+
+  #define BLOP_SIMD_F32_LOAD(ptr)        vld1q_f32(ptr)
+  #define BLOP_SIMD_F32_STORE(ptr, v)    vst1q_f32((ptr), (v))
+  #define BLOP_SIMD_F32_SET1(x)          vdupq_n_f32(x)
+  #define BLOP_SIMD_F32_ZERO()           vdupq_n_f32(0.0f)
+  #define BLOP_SIMD_F32_EQ(a, b)         vceqq_f32((a), (b))
+  #define BLOP_SIMD_F32_ADD(a, b)        vaddq_f32((a), (b))
+  #define BLOP_SIMD_F32_MUL(a, b)        vmulq_f32((a), (b))
+  #define BLOP_SIMD_F32_MIN(a, b)        vminq_f32((a), (b))
+  #define BLOP_SIMD_F32_MAX(a, b)        vmaxq_f32((a), (b))
+
+  #define BLOP_SIMD_I64_ZERO()           vdupq_n_s64(0)
+  #define BLOP_SIMD_I64_STORE(ptr, v)    vst1q_s64((ptr), (v))
+
+  #define BLOP_SIMD_MASK_ZERO()          vdupq_n_u32(0)
+  #define BLOP_SIMD_MASK_OR(a, b)        vorrq_u32((a), (b))
+  #define BLOP_SIMD_MASK_ANY(m)          (vmaxvq_u32(m) != 0)
+  #define BLOP_SIMD_MASK_COUNT(cnt, m)   vsubq_u32((cnt), (m))
+  #define BLOP_SIMD_MASK_STORE(ptr, m)   vst1q_u32((ptr), (m))
+
+  static inline blop_simd_i64v blop_simd_widen_add(blop_simd_i64v acc, blop_simd_i32v x) {
+    return vpadalq_s32(acc, x);
+  }
+  static inline blop_simd_i64v blop_simd_widen_madd(blop_simd_i64v acc, blop_simd_i32v a, blop_simd_i32v b) {
+    acc = vmlal_s32(acc, vget_low_s32(a), vget_low_s32(b));
+    return vmlal_high_s32(acc, a, b);
+  }
+#endif
+
+/* Elements scanned per early exit check of find, four vectors so the branch does not limit the loads */
+#define BLOP_SIMD_BLOCK (4 * BLOP_SIMD_LANES)
+/* Elements counted before the 32 bit lane counters are flushed, no lane can overflow within a chunk */
+#define BLOP_SIMD_COUNT_CHUNK ((size_t)1 << 30)
+
+/* Element type of each kernel family and the type its sum and dot product are accumulated in */
+typedef int32_t blop_simd_i32_type;
+typedef int64_t blop_simd_i32_wide;
+typedef float   blop_simd_f32_type;
+typedef float   blop_simd_f32_wide;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Index of the first element equal to value, count when there is none */
+static inline size_t             blop_simd_i32_find (const int32_t* data, size_t count, int32_t value) {
+  size_t i = 0;
+  #ifdef BLOP_SIMD
+    blop_simd_i32v needle = BLOP_SIMD_I32_SET1(value);
+    for (; i + BLOP_SIMD_BLOCK <= count; i += BLOP_SIMD_BLOCK) {
+      blop_simd_mask m0 = BLOP_SIMD_I32_EQ(BLOP_SIMD_I32_LOAD(&data[i]),                       needle);
+      blop_simd_mask m1 = BLOP_SIMD_I32_EQ(BLOP_SIMD_I32_LOAD(&data[i + BLOP_SIMD_LANES]),     needle);
+      blop_simd_mask m2 = BLOP_SIMD_I32_EQ(BLOP_SIMD_I32_LOAD(&data[i + 2 * BLOP_SIMD_LANES]), needle);
+      blop_simd_mask m3 = BLOP_SIMD_I32_EQ(BLOP_SIMD_I32_LOAD(&data[i + 3 * BLOP_SIMD_LANES]), needle);
+      /* The scalar loop below locates the match inside the block */
+      if (BLOP_SIMD_MASK_ANY(BLOP_SIMD_MASK_OR(BLOP_SIMD_MASK_OR(m0, m1), BLOP_SIMD_MASK_OR(m2, m3)))) {
+        break;
+      }
+    }
+  #endif
+  for (; i < count; i++) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return count;
+}
+static inline size_t             blop_simd_i32_count(const int32_t* data, size_t count, int32_t value) {
+  size_t i     = 0;
+  size_t total = 0;
+  #ifdef BLOP_SIMD
+    blop_simd_i32v needle = BLOP_SIMD_I32_SET1(value);
+    while (count - i >= BLOP_SIMD_LANES) {
+      size_t         end = i + MIN(count - i, BLOP_SIMD_COUNT_CHUNK);
+      blop_simd_mask cnt = BLOP_SIMD_MASK_ZERO();
+      for (; i + BLOP_SIMD_LANES <= end; i += BLOP_SIMD_LANES) {
+        cnt = BLOP_SIMD_MASK_COUNT(cnt, BLOP_SIMD_I32_EQ(BLOP_SIMD_I32_LOAD(&data[i]), needle));
+      }
+      uint32_t lanes[BLOP_SIMD_LANES];
+      BLOP_SIMD_MASK_STORE(lanes, cnt);
+      for (size_t l = 0; l < BLOP_SIMD_LANES; l++) {
+        total += lanes[l];
+      }
+    }
+  #endif
+  for (; i < count; i++) {
+    total += data[i] == value;
+  }
+  return total;
+}
+static inline int32_t            blop_simd_i32_min  (const int32_t* data, size_t count) {
+  size_t  i      = 0;
+  int32_t result = data[0];
+  #ifdef BLOP_SIMD
+    if (count >= BLOP_SIMD_LANES) {
+      blop_simd_i32v acc = BLOP_SIMD_I32_LOAD(data);
+      for (i = BLOP_SIMD_LANES; i + BLOP_SIMD_LANES <= count; i += BLOP_SIMD_LANES) {
+        acc = BLOP_SIMD_I32_MIN(acc, BLOP_SIMD_I32_LOAD(&data[i]));
+      }
+      int32_t lanes[BLOP_SIMD_LANES];
+      BLOP_SIMD_I32_STORE(lanes, acc);
+      for (size_t l = 0; l < BLOP_SIMD_LANES; l++) {
+        result = MIN(result, lanes[l]);
+      }
+    }
+  #endif
+  for (; i < count; i++) {
+    result = MIN(result, data[i]);
+  }
+  return result;
+}
+static inline int32_t            blop_simd_i32_max  (const int32_t* data, size_t count) {
+  size_t  i      = 0;
+  int32_t result = data[0];
+  #ifdef BLOP_SIMD
+    if (count >= BLOP_SIMD_LANES) {
+      blop_simd_i32v acc = BLOP_SIMD_I32_LOAD(data);
+      for (i = BLOP_SIMD_LANES; i + BLOP_SIMD_LANES <= count; i += BLOP_SIMD_LANES) {
+        acc = BLOP_SIMD_I32_MAX(acc, BLOP_SIMD_I32_LOAD(&data[i]));
+      }
+      int32_t lanes[BLOP_SIMD_LANES];
+      BLOP_SIMD_I32_STORE(lanes, acc);
+      for (size_t l = 0; l < BLOP_SIMD_LANES; l++) {
+        result = MAX(result, lanes[l]);
+      }
+    }
+  #endif
+  for (; i < count; i++) {
+    result = MAX(result, data[i]);
+  }
+  return result;
+}
+/* Summed in 64 bit so tens of millions of large ints do not overflow */
+static inline int64_t            blop_simd_i32_sum  (const int32_t* data, size_t count) {
+  size_t  i      = 0;
+  int64_t result = 0;
+  #ifdef BLOP_SIMD
+    blop_simd_i64v acc = BLOP_SIMD_I64_ZERO();
+    for (; i + BLOP_SIMD_LANES <= count; i += BLOP_SIMD_LANES) {
+      acc = blop_simd_widen_add(acc, BLOP_SIMD_I32_LOAD(&data[i]));
+    }
+    int64_t lanes[BLOP_SIMD_LANES / 2];
+    BLOP_SIMD_I64_STORE(lanes, acc);
+    for (size_t l = 0; l < BLOP_SIMD_LANES / 2; l++) {
+      result += lanes[l];
+    }
+  #endif
+  for (; i < count; i++) {
+    result += data[i];
+  }
+  return result;
+}
+static inline int64_t            blop_simd_i32_dot  (const int32_t* a, const int32_t* b, size_t count) {
+  size_t  i      = 0;
+  int64_t result = 0;
+  #ifdef BLOP_SIMD
+    blop_simd_i64v acc = BLOP_SIMD_I64_ZERO();
+    for (; i + BLOP_SIMD_LANES <= count; i += BLOP_SIMD_LANES) {
+      acc = blop_simd_widen_madd(acc, BLOP_SIMD_I32_LOAD(&a[i]), BLOP_SIMD_I32_LOAD(&b[i]));
+    }
+    int64_t lanes[BLOP_SIMD_LANES / 2];
+    BLOP_SIMD_I64_STORE(lanes, acc);
+    for (size_t l = 0; l < BLOP_SIMD_LANES / 2; l++) {
+      result += lanes[l];
+    }
+  #endif
+  for (; i < count; i++) {
+    result += (int64_t)a[i] * b[i];
+  }
+  return result;
+}
+static inline void               blop_simd_i32_fill (int32_t* data, size_t count, int32_t value) {
+  size_t i = 0;
+  #ifdef BLOP_SIMD
+    blop_simd_i32v v = BLOP_SIMD_I32_SET1(value);
+    for (; i + BLOP_SIMD_LANES <= count; i += BLOP_SIMD_LANES) {
+      BLOP_SIMD_I32_STORE(&data[i], v);
+    }
+  #endif
+  for (; i < count; i++) {
+    data[i] = value;
+  }
+}
+
+/* Float kernels follow ==, < and > of the scalar loop except for NaNs, which give an unspecified min/max */
+static inline size_t             blop_simd_f32_find (const float* data, size_t count, float value) {
+  size_t i = 0;
+  #ifdef BLOP_SIMD
+    blop_simd_f32v needle = BLOP_SIMD_F32_SET1(value);
+    for (; i + BLOP_SIMD_BLOCK <= count; i += BLOP_SIMD_BLOCK) {
+      blop_simd_mask m0 = BLOP_SIMD_F32_EQ(BLOP_SIMD_F32_LOAD(&data[i]),                       needle);
+      blop_simd_mask m1 = BLOP_SIMD_F32_EQ(BLOP_SIMD_F32_LOAD(&data[i + BLOP_SIMD_LANES]),     needle);
+      blop_simd_mask m2 = BLOP_SIMD_F32_EQ(BLOP_SIMD_F32_LOAD(&data[i + 2 * BLOP_SIMD_LANES]), needle);
+      blop_simd_mask m3 = BLOP_SIMD_F32_EQ(BLOP_SIMD_F32_LOAD(&data[i + 3 * BLOP_SIMD_LANES]), needle);
+      if (BLOP_SIMD_MASK_ANY(BLOP_SIMD_MASK_OR(BLOP_SIMD_MASK_OR(m0, m1), BLOP_SIMD_MASK_OR(m2, m3)))) {
+        break;
+      }
+    }
+  #endif
+  for (; i < count; i++) {
+    if (data[i] == value) {
+      return i;
+    }
+  }
+  return count;
+}
+static inline size_t             blop_simd_f32_count(const float* data, size_t count, float value) {
+  size_t i     = 0;
+  size_t total = 0;
+  #ifdef BLOP_SIMD
+    blop_simd_f32v needle = BLOP_SIMD_F32_SET1(value);
+    while (count - i >= BLOP_SIMD_LANES) {
+      size_t         end = i + MIN(count - i, BLOP_SIMD_COUNT_CHUNK);
+      blop_simd_mask cnt = BLOP_SIMD_MASK_ZERO();
+      for (; i + BLOP_SIMD_LANES <= end; i += BLOP_SIMD_LANES) {
+        cnt = BLOP_SIMD_MASK_COUNT(cnt, BLOP_SIMD_F32_EQ(BLOP_SIMD_F32_LOAD(&data[i]), needle));
+      }
+      uint32_t lanes[BLOP_SIMD_LANES];
+      BLOP_SIMD_MASK_STORE(lanes, cnt);
+      for (size_t l = 0; l < BLOP_SIMD_LANES; l++) {
+        total += lanes[l];
+      }
+    }
+  #endif
+  for (; i < count; i++) {
+    total += data[i] == value;
+  }
+  return total;
+}
+static inline float              blop_simd_f32_min  (const float* data, size_t count) {
+  size_t i      = 0;
+  float  result = data[0];
+  #ifdef BLOP_SIMD
+    if (count >= BLOP_SIMD_LANES) {
+      blop_simd_f32v acc = BLOP_SIMD_F32_LOAD(data);
+      for (i = BLOP_SIMD_LANES; i + BLOP_SIMD_LANES <= count; i += BLOP_SIMD_LANES) {
+        acc = BLOP_SIMD_F32_MIN(acc, BLOP_SIMD_F32_LOAD(&data[i]));
+      }
+      float lanes[BLOP_SIMD_LANES];
+      BLOP_SIMD_F32_STORE(lanes, acc);
+      for (size_t l = 0; l < BLOP_SIMD_LANES; l++) {
+        result = MIN(result, lanes[l]);
+      }
+    }
+  #endif
+  for (; i < count; i++) {
+    result = MIN(result, data[i]);
+  }
+  return result;
+}
+static inline float              blop_simd_f32_max  (const float* data, size_t count) {
+  size_t i      = 0;
+  float  result = data[0];
+  #ifdef BLOP_SIMD
+    if (count >= BLOP_SIMD_LANES) {
+      blop_simd_f32v acc = BLOP_SIMD_F32_LOAD(data);
+      for (i = BLOP_SIMD_LANES; i + BLOP_SIMD_LANES <= count; i += BLOP_SIMD_LANES) {
+        acc = BLOP_SIMD_F32_MAX(acc, BLOP_SIMD_F32_LOAD(&data[i]));
+      }
+      float lanes[BLOP_SIMD_LANES];
+      BLOP_SIMD_F32_STORE(lanes, acc);
+      for (size_t l = 0; l < BLOP_SIMD_LANES; l++) {
+        result = MAX(result, lanes[l]);
+      }
+    }
+  #endif
+  for (; i < count; i++) {
+    result = MAX(result, data[i]);
+  }
+  return result;
+}
+/* Four independent accumulators hide the add latency, so the rounding differs slightly from a sequential sum */
+static inline float              blop_simd_f32_sum  (const float* data, size_t count) {
+  size_t i      = 0;
+  float  result = 0.0f;
+  #ifdef BLOP_SIMD
+    blop_simd_f32v acc[4] = { BLOP_SIMD_F32_ZERO(), BLOP_SIMD_F32_ZERO(), BLOP_SIMD_F32_ZERO(), BLOP_SIMD_F32_ZERO() };
+    for (; i + BLOP_SIMD_BLOCK <= count; i += BLOP_SIMD_BLOCK) {
+      for (size_t k = 0; k < 4; k++) {
+        acc[k] = BLOP_SIMD_F32_ADD(acc[k], BLOP_SIMD_F32_LOAD(&data[i + k * BLOP_SIMD_LANES]));
+      }
+    }
+    float lanes[BLOP_SIMD_LANES];
+    BLOP_SIMD_F32_STORE(lanes, BLOP_SIMD_F32_ADD(BLOP_SIMD_F32_ADD(acc[0], acc[1]), BLOP_SIMD_F32_ADD(acc[2], acc[3])));
+    for (size_t l = 0; l < BLOP_SIMD_LANES; l++) {
+      result += lanes[l];
+    }
+  #endif
+  for (; i < count; i++) {
+    result += data[i];
+  }
+  return result;
+}
+static inline float              blop_simd_f32_dot  (const float* a, const float* b, size_t count) {
+  size_t i      = 0;
+  float  result = 0.0f;
+  #ifdef BLOP_SIMD
+    blop_simd_f32v acc[4] = { BLOP_SIMD_F32_ZERO(), BLOP_SIMD_F32_ZERO(), BLOP_SIMD_F32_ZERO(), BLOP_SIMD_F32_ZERO() };
+    for (; i + BLOP_SIMD_BLOCK <= count; i += BLOP_SIMD_BLOCK) {
+      for (size_t k = 0; k < 4; k++) {
+        size_t j = i + k * BLOP_SIMD_LANES;
+        acc[k] = BLOP_SIMD_F32_ADD(acc[k], BLOP_SIMD_F32_MUL(BLOP_SIMD_F32_LOAD(&a[j]), BLOP_SIMD_F32_LOAD(&b[j])));
+      }
+    }
+    float lanes[BLOP_SIMD_LANES];
+    BLOP_SIMD_F32_STORE(lanes, BLOP_SIMD_F32_ADD(BLOP_SIMD_F32_ADD(acc[0], acc[1]), BLOP_SIMD_F32_ADD(acc[2], acc[3])));
+    for (size_t l = 0; l < BLOP_SIMD_LANES; l++) {
+      result += lanes[l];
+    }
+  #endif
+  for (; i < count; i++) {
+    result += a[i] * b[i];
+  }
+  return result;
+}
+static inline void               blop_simd_f32_fill (float* data, size_t count, float value) {
+  size_t i = 0;
+  #ifdef BLOP_SIMD
+    blop_simd_f32v v = BLOP_SIMD_F32_SET1(value);
+    for (; i + BLOP_SIMD_LANES <= count; i += BLOP_SIMD_LANES) {
+      BLOP_SIMD_F32_STORE(&data[i], v);
+    }
+  #endif
+  for (; i < count; i++) {
+    data[i] = value;
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLOP_SIMD_H__ */
@@ -1,3 +1,4 @@
+#include <stddef.h>
 #include <blop/blop.h>
 
 #ifndef SLAB_NAME
@@ -16,28 +17,176 @@
   #define SLAB_OBJECTS_COUNT 1024
 #endif
 
-#define struct_slab       SLAB_NAME
-#define struct_block      CONCAT2(SLAB_NAME, _block)
+/* The first block holds SLAB_OBJECTS_MIN objects and every new block doubles the last one up to SLAB_OBJECTS_COUNT */
+#ifndef SLAB_OBJECTS_MIN
+  #define SLAB_OBJECTS_MIN 64
+#endif /* SLAB_OBJECTS_MIN */
 
-#define fn_block_create   CONCAT2(SLAB_FN_PREFIX, _block_create)
-#define fn_block_destroy  CONCAT2(SLAB_FN_PREFIX, _block_destroy)
-#define fn_block_clear    CONCAT2(SLAB_FN_PREFIX, _block_clear)
+/* Objects are built by SLAB_CONSTRUCT(ptr) the first time they are handed out and torn down by SLAB_DESTRUCT(ptr) only when their block is released */
+#if defined(SLAB_CONSTRUCT) || defined(SLAB_DESTRUCT)
+  /* Freed objects keep their state and must be given back constructed, so their free links are kept out of them */
+  #define SLAB_CACHED
 
-#define fn_slab_create    CONCAT2(SLAB_FN_PREFIX, _create)
-#define fn_slab_destroy   CONCAT2(SLAB_FN_PREFIX, _destroy)
+  #ifdef SLAB_REMOTE_FREE
+    #error "SLAB_REMOTE_FREE links freed objects through their own memory and can not be combined with SLAB_CONSTRUCT/SLAB_DESTRUCT"
+  #endif /* SLAB_REMOTE_FREE */
+#endif /* SLAB_CONSTRUCT || SLAB_DESTRUCT */
 
-#define fn_slab_rdlock    CONCAT2(SLAB_FN_PREFIX, _rdlock)
-#define fn_slab_wrlock    CONCAT2(SLAB_FN_PREFIX, _wrlock)
-#define fn_slab_rdunlock  CONCAT2(SLAB_FN_PREFIX, _rdunlock)
-#define fn_slab_wrunlock  CONCAT2(SLAB_FN_PREFIX, _wrunlock)
+/* Lock free and cached blocks keep one free link per object right after mem */
+#if defined(SLAB_LOCKFREE) || defined(SLAB_CACHED)
+  #define SLAB_BLOCK_BYTES(capacity) (offsetof(struct struct_block, mem) + (size_t)(capacity) * (sizeof(struct_slot) + sizeof(uint32_t)))
+#else
+  #define SLAB_BLOCK_BYTES(capacity) (offsetof(struct struct_block, mem) + (size_t)(capacity) * sizeof(struct_slot))
+#endif /* SLAB_LOCKFREE || SLAB_CACHED */
 
-#define fn_slab_clear     CONCAT2(SLAB_FN_PREFIX, _clear)
-#define fn_slab_free      CONCAT2(SLAB_FN_PREFIX, _free)
-#define fn_slab_alloc     CONCAT2(SLAB_FN_PREFIX, _alloc)
+/* Blocks of every size, the small first ones included, are allocated at this (power of two) alignment so the owning block of any object is found by masking its address.
+ * Each block reserves up to SLAB_BLOCK_ALIGN bytes of address space (and fragments the heap with the default allocator), so the default is capped at SLAB_BLOCK_ALIGN_MAX (power of two)
+ * and blocks stop growing once they would not fit in SLAB_BLOCK_ALIGN */
+#ifndef SLAB_BLOCK_ALIGN_MAX
+  #define SLAB_BLOCK_ALIGN_MAX ((size_t)64 << 10)
+#endif /* SLAB_BLOCK_ALIGN_MAX */
 
-#define fn_slab_size      CONCAT2(SLAB_FN_PREFIX, _size)
-#define fn_slab_print_out CONCAT2(SLAB_FN_PREFIX, _print_out)
-#define fn_slab_print_err CONCAT2(SLAB_FN_PREFIX, _print_err)
+#ifndef SLAB_BLOCK_ALIGN
+  #define SLAB_BLOCK_ALIGN BLOP_NEXT_POW2(MIN(SLAB_BLOCK_BYTES(SLAB_OBJECTS_COUNT), MAX((size_t)SLAB_BLOCK_ALIGN_MAX, SLAB_BLOCK_BYTES(SLAB_OBJECTS_MIN))))
+#endif /* SLAB_BLOCK_ALIGN */
+
+/* Largest block that fits in SLAB_BLOCK_ALIGN */
+#define SLAB_BLOCK_CAPACITY MIN((size_t)SLAB_OBJECTS_COUNT, (SLAB_BLOCK_ALIGN - SLAB_BLOCK_BYTES(0)) / (SLAB_BLOCK_BYTES(1) - SLAB_BLOCK_BYTES(0)))
+
+#define SLAB_BITMAP_WORDS ((SLAB_OBJECTS_COUNT + 63) / 64)
+
+/* Every object starts at a multiple of SLAB_ALIGNMENT (power of two), SLAB_PAD_TO_CACHELINE gives each object whole cache lines of its own */
+#ifdef SLAB_PAD_TO_CACHELINE
+  #ifndef SLAB_ALIGNMENT
+    #define SLAB_ALIGNMENT CACHE_LINE_SIZE
+  #elif SLAB_ALIGNMENT < CACHE_LINE_SIZE
+    #error "SLAB_ALIGNMENT can not be smaller than CACHE_LINE_SIZE with SLAB_PAD_TO_CACHELINE"
+  #endif /* SLAB_ALIGNMENT */
+#endif /* SLAB_PAD_TO_CACHELINE */
+
+#if defined(SLAB_ALIGNMENT) && (SLAB_ALIGNMENT <= 0 || (SLAB_ALIGNMENT & (SLAB_ALIGNMENT - 1)) != 0)
+  #error "SLAB_ALIGNMENT must be a power of two"
+#endif
+
+/* Where blocks come from, SLAB_BLOCK_ALLOC(size, align) must return align aligned memory (e.g. pages_alloc from blop/pages.h) */
+#ifndef SLAB_BLOCK_ALLOC
+  #define SLAB_BLOCK_ALLOC(size, align) blop_aligned_alloc((align), (size))
+  #define SLAB_BLOCK_FREE(ptr, size)    blop_aligned_free((ptr))
+#endif /* SLAB_BLOCK_ALLOC */
+
+/* Enable per thread magazine caches (fn_slab_cache_*), every thread must call fn_slab_cache_flush before it exits and before the slab is cleared, reset or destroyed */
+#ifdef SLAB_MAGAZINES
+  #ifndef SLAB_MAGAZINE_SIZE
+    #define SLAB_MAGAZINE_SIZE 64
+  #endif /* SLAB_MAGAZINE_SIZE */
+
+  /* How many slabs of this type a single thread can cache at the same time */
+  #ifndef SLAB_MAGAZINE_SLOTS
+    #define SLAB_MAGAZINE_SLOTS 4
+  #endif /* SLAB_MAGAZINE_SLOTS */
+#endif /* SLAB_MAGAZINES */
+
+/* Free empty blocks automatically once more than SLAB_TRIM_HIGH of them pile up, keeping SLAB_TRIM_LOW as spares */
+#ifdef SLAB_TRIM_AUTO
+  #ifndef SLAB_TRIM_LOW
+    #define SLAB_TRIM_LOW 1
+  #endif /* SLAB_TRIM_LOW */
+
+  #ifndef SLAB_TRIM_HIGH
+    #define SLAB_TRIM_HIGH (2 * SLAB_TRIM_LOW + 2)
+  #endif /* SLAB_TRIM_HIGH */
+
+  #if SLAB_TRIM_HIGH <= SLAB_TRIM_LOW
+    #error "SLAB_TRIM_HIGH must be greater than SLAB_TRIM_LOW"
+  #endif
+#endif /* SLAB_TRIM_AUTO */
+
+/* Count allocs, frees and the peak of live objects for fn_slab_stats, nothing is counted when it is not defined */
+#ifdef SLAB_STATS
+  /* Per block occupancy histogram resolution, empty blocks get a bucket of their own on top of these */
+  #ifndef SLAB_STATS_BUCKETS
+    #define SLAB_STATS_BUCKETS 8
+  #endif /* SLAB_STATS_BUCKETS */
+#endif /* SLAB_STATS */
+
+/* Frees from threads other than the owner go to a lock free queue that the owner drains on its next alloc (fn_slab_collect) */
+#ifdef SLAB_REMOTE_FREE
+  #ifdef SLAB_LOCKFREE
+    #error "SLAB_LOCKFREE and SLAB_REMOTE_FREE can not be combined"
+  #endif /* SLAB_LOCKFREE */
+
+  #include <stdatomic.h>
+#endif /* SLAB_REMOTE_FREE */
+
+/* Enable the lock free mode (C11 atomics, every block free list is a tagged Treiber stack) */
+#ifdef SLAB_LOCKFREE
+  #ifdef SLAB_MAGAZINES
+    #error "SLAB_LOCKFREE and SLAB_MAGAZINES can not be combined"
+  #endif /* SLAB_MAGAZINES */
+
+  #ifdef SLAB_TRIM_AUTO
+    #error "SLAB_LOCKFREE and SLAB_TRIM_AUTO can not be combined"
+  #endif /* SLAB_TRIM_AUTO */
+
+  #include <stdatomic.h>
+#endif /* SLAB_LOCKFREE */
+
+#define struct_slab         SLAB_NAME
+#define struct_block        CONCAT2(SLAB_NAME, _block)
+#define struct_slot         CONCAT2(SLAB_NAME, _slot)
+#define struct_magazine     CONCAT2(SLAB_NAME, _magazine)
+#define struct_cache        CONCAT2(SLAB_NAME, _cache)
+#define struct_stats        CONCAT2(SLAB_NAME, _stats)
+
+#define fn_block_create     CONCAT2(SLAB_FN_PREFIX, _block_create)
+#define fn_block_destroy    CONCAT2(SLAB_FN_PREFIX, _block_destroy)
+#define fn_block_clear      CONCAT2(SLAB_FN_PREFIX, _block_clear)
+#define fn_block_reset      CONCAT2(SLAB_FN_PREFIX, _block_reset)
+#define fn_block_list       CONCAT2(SLAB_FN_PREFIX, _block_list)
+#define fn_block_link       CONCAT2(SLAB_FN_PREFIX, _block_link)
+#define fn_block_unlink     CONCAT2(SLAB_FN_PREFIX, _block_unlink)
+#define fn_block_move       CONCAT2(SLAB_FN_PREFIX, _block_move)
+#define fn_block_push       CONCAT2(SLAB_FN_PREFIX, _block_push)
+#define fn_block_pop        CONCAT2(SLAB_FN_PREFIX, _block_pop)
+
+#define fn_magazine_create  CONCAT2(SLAB_FN_PREFIX, _magazine_create)
+#define slab_caches         CONCAT2(SLAB_NAME, _caches)
+
+#define fn_slab_create      CONCAT2(SLAB_FN_PREFIX, _create)
+#define fn_slab_destroy     CONCAT2(SLAB_FN_PREFIX, _destroy)
+
+#define fn_slab_rdlock      CONCAT2(SLAB_FN_PREFIX, _rdlock)
+#define fn_slab_wrlock      CONCAT2(SLAB_FN_PREFIX, _wrlock)
+#define fn_slab_rdunlock    CONCAT2(SLAB_FN_PREFIX, _rdunlock)
+#define fn_slab_wrunlock    CONCAT2(SLAB_FN_PREFIX, _wrunlock)
+
+#define fn_slab_block       CONCAT2(SLAB_FN_PREFIX, _block)
+#define fn_slab_clear       CONCAT2(SLAB_FN_PREFIX, _clear)
+#define fn_slab_reset       CONCAT2(SLAB_FN_PREFIX, _reset)
+#define fn_slab_trim        CONCAT2(SLAB_FN_PREFIX, _trim)
+#define fn_slab_free        CONCAT2(SLAB_FN_PREFIX, _free)
+#define fn_slab_alloc       CONCAT2(SLAB_FN_PREFIX, _alloc)
+#define fn_slab_free_n      CONCAT2(SLAB_FN_PREFIX, _free_n)
+#define fn_slab_alloc_n     CONCAT2(SLAB_FN_PREFIX, _alloc_n)
+#define fn_slab_foreach     CONCAT2(SLAB_FN_PREFIX, _foreach)
+#define type_slab_foreach   CONCAT2(SLAB_NAME, _foreach_fn)
+
+#define fn_slab_adopt       CONCAT2(SLAB_FN_PREFIX, _adopt)
+#define fn_slab_collect     CONCAT2(SLAB_FN_PREFIX, _collect)
+
+#define fn_slab_cache       CONCAT2(SLAB_FN_PREFIX, _cache)
+#define fn_slab_cache_free  CONCAT2(SLAB_FN_PREFIX, _cache_free)
+#define fn_slab_cache_alloc CONCAT2(SLAB_FN_PREFIX, _cache_alloc)
+#define fn_slab_cache_flush CONCAT2(SLAB_FN_PREFIX, _cache_flush)
+#define fn_slab_cache_purge CONCAT2(SLAB_FN_PREFIX, _cache_purge)
+
+#define fn_slab_size        CONCAT2(SLAB_FN_PREFIX, _size)
+#define fn_slab_print_out   CONCAT2(SLAB_FN_PREFIX, _print_out)
+#define fn_slab_print_err   CONCAT2(SLAB_FN_PREFIX, _print_err)
+
+#define fn_slab_stats       CONCAT2(SLAB_FN_PREFIX, _stats)
+#define fn_slab_dump_out    CONCAT2(SLAB_FN_PREFIX, _dump_out)
+#define fn_slab_dump_err    CONCAT2(SLAB_FN_PREFIX, _dump_err)
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,11 +194,25 @@ extern "C" {
 
 struct struct_slab;
 struct struct_block;
+union  struct_slot;
 typedef struct struct_slab struct_slab;
 typedef struct struct_block struct_block;
+typedef union  struct_slot struct_slot;
 
-struct_block*   fn_block_create   (struct_block* block);
+struct_block*   fn_block_create   (struct_slab* slab);
 void            fn_block_destroy  (struct_block* block);
+void            fn_block_clear    (struct_block* block);
+void            fn_block_reset    (struct_block* block);
+
+#ifndef SLAB_LOCKFREE
+  struct_block**  fn_block_list     (struct_slab* slab, struct_block* block);
+  void            fn_block_link     (struct_block** list, struct_block* block);
+  void            fn_block_unlink   (struct_block** list, struct_block* block);
+  void            fn_block_move     (struct_block* block, struct_block** src);
+#endif /* SLAB_LOCKFREE */
+
+void            fn_block_push     (struct_block* block, SLAB_DATA_TYPE* ptr);
+SLAB_DATA_TYPE* fn_block_pop      (struct_block* block);
 
 struct_slab*    fn_slab_create    (struct_slab* slab);
 void            fn_slab_destroy   (struct_slab* slab);
@@ -59,55 +222,475 @@ void            fn_slab_wrlock    (struct_slab* slab);
 void            fn_slab_rdunlock  (struct_slab* slab);
 void            fn_slab_wrunlock  (struct_slab* slab);
 
+struct_block*   fn_slab_block     (struct_slab* slab, SLAB_DATA_TYPE* ptr);
 void            fn_slab_clear     (struct_slab* slab);
+void            fn_slab_reset     (struct_slab* slab);
+size_t          fn_slab_trim      (struct_slab* slab, size_t spares);
 void            fn_slab_free      (struct_slab* slab, SLAB_DATA_TYPE* ptr);
 SLAB_DATA_TYPE* fn_slab_alloc     (struct_slab* slab);
 
+/* The callback must not alloc or free from the slab, collect the objects and use fn_slab_free_n afterwards */
+typedef void (*type_slab_foreach)(SLAB_DATA_TYPE* ptr, void* ctx);
+
+void            fn_slab_free_n    (struct_slab* slab, SLAB_DATA_TYPE** ptrs, size_t count);
+void            fn_slab_alloc_n   (struct_slab* slab, SLAB_DATA_TYPE** out,  size_t count);
+void            fn_slab_foreach   (struct_slab* slab, type_slab_foreach fn,  void* ctx);
+
+#ifdef SLAB_REMOTE_FREE
+  void            fn_slab_adopt     (struct_slab* slab);
+  size_t          fn_slab_collect   (struct_slab* slab);
+#endif /* SLAB_REMOTE_FREE */
+
+#ifdef SLAB_MAGAZINES
+  struct struct_magazine;
+  struct struct_cache;
+  typedef struct struct_magazine struct_magazine;
+  typedef struct struct_cache struct_cache;
+
+  struct_cache*   fn_slab_cache       (struct_slab* slab);
+  void            fn_slab_cache_free  (struct_slab* slab, SLAB_DATA_TYPE* ptr);
+  SLAB_DATA_TYPE* fn_slab_cache_alloc (struct_slab* slab);
+  void            fn_slab_cache_flush (struct_slab* slab);
+  void            fn_slab_cache_purge (struct_slab* slab);
+#endif /* SLAB_MAGAZINES */
+
 size_t          fn_slab_size      (struct_slab* slab);
 void            fn_slab_print_out (struct_slab* slab);
 void            fn_slab_print_err (struct_slab* slab);
 
+#ifdef SLAB_STATS
+  struct struct_stats;
+  typedef struct struct_stats struct_stats;
+
+  void            fn_slab_stats     (struct_slab* slab, struct_stats* stats);
+  void            fn_slab_dump_out  (struct_slab* slab);
+  void            fn_slab_dump_err  (struct_slab* slab);
+#endif /* SLAB_STATS */
+
 #ifdef SLAB_STRUCT
+  /* A freed object stores the index + 1 of the next freed object of its block in its own memory (after mem when SLAB_CACHED),
+   * objects from bump onwards were never handed out and are not linked at all */
+  union struct_slot {
+    SLAB_DATA_TYPE        data;
+    uint32_t              next;
+
+    /* Raises the alignment of the whole slot, which also rounds its size (the stride of mem) up to a multiple of it */
+    #ifdef SLAB_ALIGNMENT
+      ALIGNAS(SLAB_ALIGNMENT) uint8_t align;
+    #endif /* SLAB_ALIGNMENT */
+
+    #ifdef SLAB_REMOTE_FREE
+      union struct_slot*  remote;
+    #endif /* SLAB_REMOTE_FREE */
+  };
+#endif /* SLAB_STRUCT */
+
+#if defined(SLAB_STRUCT) && !defined(SLAB_LOCKFREE)
   struct struct_block {
-    int                   allocated;
-    SLAB_DATA_TYPE        mem[SLAB_OBJECTS_COUNT];
-    SLAB_DATA_TYPE*       free_list[SLAB_OBJECTS_COUNT];
-    size_t                free_count;
-    char                  allocated_list[SLAB_OBJECTS_COUNT];
+    struct struct_slab*   slab;
+    struct struct_block*  prev;
     struct struct_block*  next;
+    size_t                free_count;
+    uint32_t              free_head;
+    uint32_t              bump;
+    uint32_t              capacity;
+    #ifdef SLAB_CACHED
+      uint32_t            constructed;
+    #endif /* SLAB_CACHED */
+    uint64_t              allocated_bits[SLAB_BITMAP_WORDS];
+    struct_slot           mem[];
   };
 
+  #ifdef SLAB_MAGAZINES
+    struct struct_magazine {
+      struct struct_magazine* next;
+      size_t                  rounds;
+      SLAB_DATA_TYPE*         objects[SLAB_MAGAZINE_SIZE];
+    };
+
+    struct struct_cache {
+      struct struct_slab*     slab;
+      struct struct_magazine* loaded;
+      struct struct_magazine* previous;
+    };
+  #endif /* SLAB_MAGAZINES */
+
   struct struct_slab {
     int                   allocated;
-    struct struct_block   block;
+    struct struct_block*  partial;
+    struct struct_block*  full;
+    struct struct_block*  empty;
+    size_t                empty_count;
+    size_t                blocks;
     size_t                total;
     RWLOCK_TYPE           lock;
+
+    #ifdef SLAB_STATS
+      size_t              peak;
+      size_t              allocs;
+      size_t              frees;
+    #endif /* SLAB_STATS */
+
+    #ifdef SLAB_MAGAZINES
+      struct struct_magazine* depot_full;
+      struct struct_magazine* depot_empty;
+      size_t                  caches;
+      RWLOCK_TYPE             depot_lock;
+    #endif /* SLAB_MAGAZINES */
+
+    /* Remote frees stay live (and counted in total) until the owner collects them */
+    #ifdef SLAB_REMOTE_FREE
+      uintptr_t                     owner;
+      _Atomic(union struct_slot*)   remote;
+    #endif /* SLAB_REMOTE_FREE */
   };
-#endif /* SLAB_STRUCT */
+#endif /* SLAB_STRUCT && !SLAB_LOCKFREE */
+
+#if defined(SLAB_STRUCT) && defined(SLAB_LOCKFREE)
+  /* head packs a 32 bit ABA tag over the index + 1 of the top free object, links (right after mem) hold the index + 1 of the next one.
+   * Links stay out of the objects because a stale pop may still read one while the new owner writes the object */
+  struct struct_block {
+    struct struct_slab*   slab;
+    struct struct_block*  next;
+    _Atomic uint64_t      head;
+    _Atomic uint32_t      bump;
+    uint32_t              capacity;
+    #ifdef SLAB_CACHED
+      uint32_t            constructed;
+    #endif /* SLAB_CACHED */
+    _Atomic uint64_t      allocated_bits[SLAB_BITMAP_WORDS];
+    struct_slot           mem[];
+  };
+
+  struct struct_slab {
+    int                             allocated;
+    _Atomic(struct struct_block*)   block;
+    _Atomic(struct struct_block*)   hint;
+    _Atomic size_t                  blocks;
+    _Atomic size_t                  total;
+    RWLOCK_TYPE                     lock;
+
+    #ifdef SLAB_STATS
+      _Atomic size_t                peak;
+      _Atomic size_t                allocs;
+      _Atomic size_t                frees;
+    #endif /* SLAB_STATS */
+  };
+#endif /* SLAB_STRUCT && SLAB_LOCKFREE */
+
+#if defined(SLAB_STRUCT) && defined(SLAB_STATS)
+  /* block_bytes and capacity add up every block, capacity_min and capacity_max are the smallest and largest block (blocks grow geometrically).
+   * histogram[0] counts empty blocks, histogram[i] blocks holding up to i / SLAB_STATS_BUCKETS of their objects */
+  struct struct_stats {
+    size_t                blocks;
+    size_t                block_bytes;
+    size_t                capacity_min;
+    size_t                capacity_max;
+    size_t                capacity;
+    size_t                live;
+    size_t                peak;
+    size_t                allocs;
+    size_t                frees;
+    size_t                histogram[SLAB_STATS_BUCKETS + 1];
+  };
+#endif /* SLAB_STRUCT && SLAB_STATS */
 
 #ifdef SLAB_IMPLEMENTATION
 
-struct_block*   fn_block_create(struct_block* block) {
-  if (!block) {
-    CALLOC(block, struct_block, 1);
-    block->allocated = true;
-  } else {
-    block->allocated = false;
-  }
+/* The header sits at the aligned base of the block, reading it for a foreign ptr is only safe if that memory is mapped */
+#define SLAB_PTR_TO_BLOCK(ptr)          ((struct_block*)((uintptr_t)(ptr) & ~((uintptr_t)SLAB_BLOCK_ALIGN - 1)))
+#define SLAB_PTR_TO_INDEX(block, ptr)   ((size_t)((struct_slot*)(ptr) - (block)->mem))
+#define SLAB_BLOCK_OWNS(block, ptr)     ((struct_slot*)(ptr) >= &(block)->mem[0] && (struct_slot*)(ptr) < &(block)->mem[(block)->capacity])
+#define SLAB_BLOCK_LINKS(block)         ((_Atomic uint32_t*)&(block)->mem[(block)->capacity])
+
+/* Objects below constructed (or below bump, which can be ahead of it until the next reset) hold a constructed object */
+#ifdef SLAB_CACHED
+  #define SLAB_LINK(block, idx)         (((uint32_t*)&(block)->mem[(block)->capacity])[idx])
+  #define SLAB_BUILT(block, bump)       MAX((size_t)(block)->constructed, (size_t)(bump))
+#else
+  #define SLAB_LINK(block, idx)         ((block)->mem[idx].next)
+#endif /* SLAB_CACHED */
+
+#ifdef SLAB_CONSTRUCT
+  #define SLAB_BUILD(block, idx)        do { if ((idx) >= (block)->constructed) { SLAB_CONSTRUCT(&(block)->mem[idx].data); } } while(0)
+#else
+  #define SLAB_BUILD(block, idx)        ((void)0)
+#endif /* SLAB_CONSTRUCT */
+#define SLAB_BIT(idx)                   ((uint64_t)1 << ((idx) & 63))
+
+STATIC_ASSERT((SLAB_BLOCK_ALIGN & (SLAB_BLOCK_ALIGN - 1)) == 0, "SLAB_BLOCK_ALIGN must be a power of two");
+STATIC_ASSERT((SLAB_BLOCK_ALIGN_MAX & (SLAB_BLOCK_ALIGN_MAX - 1)) == 0, "SLAB_BLOCK_ALIGN_MAX must be a power of two");
+STATIC_ASSERT(SLAB_BLOCK_BYTES(1) <= SLAB_BLOCK_ALIGN, "SLAB_BLOCK_ALIGN is smaller than a block of one object");
+
+#ifdef SLAB_ALIGNMENT
+  STATIC_ASSERT(SLAB_BLOCK_ALIGN % SLAB_ALIGNMENT == 0, "SLAB_BLOCK_ALIGN is not a multiple of SLAB_ALIGNMENT");
+  STATIC_ASSERT(sizeof(struct_slot) % SLAB_ALIGNMENT == 0, "Slab object stride is not a multiple of SLAB_ALIGNMENT");
+  STATIC_ASSERT(offsetof(struct struct_block, mem) % SLAB_ALIGNMENT == 0, "Slab objects do not start SLAB_ALIGNMENT aligned in the block");
+#endif /* SLAB_ALIGNMENT */
+
+#ifdef SLAB_PAD_TO_CACHELINE
+  STATIC_ASSERT(sizeof(struct_slot) % CACHE_LINE_SIZE == 0, "Slab objects share cache lines despite SLAB_PAD_TO_CACHELINE");
+#endif /* SLAB_PAD_TO_CACHELINE */
 
-  block->free_count = SLAB_OBJECTS_COUNT;
-  for (size_t i = 0; i < SLAB_OBJECTS_COUNT; i++) {
-    block->free_list[i] = &block->mem[SLAB_OBJECTS_COUNT - i - 1];
+/* Called right after total changes, they expand to nothing without SLAB_STATS */
+#if defined(SLAB_STATS) && !defined(SLAB_LOCKFREE)
+  #define SLAB_STATS_ALLOC(slab, n)     do { (slab)->allocs += (n); (slab)->peak = MAX((slab)->peak, (slab)->total); } while(0)
+  #define SLAB_STATS_FREE(slab, n)      do { (slab)->frees += (n); } while(0)
+#elif defined(SLAB_STATS)
+  #define SLAB_STATS_ALLOC(slab, n)     do { atomic_fetch_add_explicit(&(slab)->allocs, (n), memory_order_relaxed); } while(0)
+  #define SLAB_STATS_FREE(slab, n)      do { atomic_fetch_add_explicit(&(slab)->frees, (n), memory_order_relaxed); } while(0)
+#else
+  #define SLAB_STATS_ALLOC(slab, n)     ((void)0)
+  #define SLAB_STATS_FREE(slab, n)      ((void)0)
+#endif /* SLAB_STATS */
+
+#ifdef SLAB_MAGAZINES
+  /* Every thread keeps a loaded and a previous magazine per slab, objects sitting in them still count as allocated */
+  static THREAD_LOCAL struct_cache slab_caches[SLAB_MAGAZINE_SLOTS];
+#endif /* SLAB_MAGAZINES */
+
+struct_block*   fn_block_create(struct_slab* slab) {
+  BLOP_ASSERT_PTR(slab);
+
+  /* Small slabs stay in a few small blocks, big ones quickly reach full size blocks and keep the block lists short */
+  size_t capacity = MIN((size_t)SLAB_OBJECTS_MIN, SLAB_BLOCK_CAPACITY);
+  for (size_t i = 0; i < slab->blocks && capacity < SLAB_BLOCK_CAPACITY; i++) {
+    capacity = MIN(capacity * 2, SLAB_BLOCK_CAPACITY);
   }
 
+  /* Objects are handed out lazily from the bump index, so only the header and the bitmap need to be initialized */
+  struct_block* block = (struct_block*)SLAB_BLOCK_ALLOC(SLAB_BLOCK_BYTES(capacity), SLAB_BLOCK_ALIGN);
+  ASSERT_MALLOC(block, struct_block, SLAB_BLOCK_BYTES(capacity));
+  memset(block->allocated_bits, 0, sizeof(block->allocated_bits));
+
+  block->slab     = slab;
+  block->next     = NULL;
+  block->capacity = (uint32_t)capacity;
+  #ifdef SLAB_CACHED
+    block->constructed = 0;
+  #endif /* SLAB_CACHED */
+  #ifndef SLAB_LOCKFREE
+    block->prev = NULL;
+    block->bump = 0;
+  #else
+    atomic_init(&block->head, 0);
+    atomic_init(&block->bump, 0);
+  #endif /* SLAB_LOCKFREE */
+  fn_block_reset(block);
+
+  slab->blocks++;
   return block;
 }
 void            fn_block_destroy(struct_block* block) {
-  if (block->allocated) {
-    FREE(block);
+  BLOP_ASSERT_PTR(block);
+
+  #ifdef SLAB_DESTRUCT
+    #ifndef SLAB_LOCKFREE
+      size_t built = SLAB_BUILT(block, block->bump);
+    #else
+      size_t built = SLAB_BUILT(block, atomic_load_explicit(&block->bump, memory_order_relaxed));
+    #endif /* SLAB_LOCKFREE */
+    for (size_t i = 0; i < built; i++) {
+      SLAB_DESTRUCT(&block->mem[i].data);
+    }
+  #endif /* SLAB_DESTRUCT */
+
+  block->slab->blocks--;
+  SLAB_BLOCK_FREE(block, SLAB_BLOCK_BYTES(block->capacity));
+}
+void            fn_block_clear(struct_block* block) {
+  BLOP_ASSERT_PTR(block);
+
+  #ifdef SLAB_DEALLOCATE_DATA
+    size_t words = ((size_t)block->bump + 63) / 64;
+    for (size_t i = 0; i < words; i++) {
+      uint64_t bits = block->allocated_bits[i];
+      while (bits) {
+        size_t idx = i * 64 + (size_t)blop_ctz64(bits);
+        SLAB_DEALLOCATE_DATA(&block->mem[idx].data);
+        bits &= bits - 1;
+      }
+    }
+  #endif /* SLAB_DEALLOCATE_DATA */
+
+  fn_block_reset(block);
+}
+void            fn_block_reset(struct_block* block) {
+  BLOP_ASSERT_PTR(block);
+
+  /* Bits at or past bump are always clear, so rewinding only costs the words that were ever used */
+  size_t words = ((size_t)block->bump + 63) / 64;
+
+  /* Rewound objects stay constructed, bump hands them out again without building them twice */
+  #ifdef SLAB_CACHED
+    #ifndef SLAB_LOCKFREE
+      block->constructed = (uint32_t)SLAB_BUILT(block, block->bump);
+    #else
+      block->constructed = (uint32_t)SLAB_BUILT(block, atomic_load_explicit(&block->bump, memory_order_relaxed));
+    #endif /* SLAB_LOCKFREE */
+  #endif /* SLAB_CACHED */
+
+  #ifndef SLAB_LOCKFREE
+    memset(block->allocated_bits, 0, words * sizeof(uint64_t));
+    block->free_count = block->capacity;
+    block->free_head  = 0;
+    block->bump       = 0;
+  #else
+    for (size_t i = 0; i < words; i++) {
+      atomic_store_explicit(&block->allocated_bits[i], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&block->bump, 0, memory_order_relaxed);
+    uint64_t tag = atomic_load_explicit(&block->head, memory_order_relaxed) >> 32;
+    atomic_store_explicit(&block->head, (tag + 1) << 32, memory_order_release);
+  #endif /* SLAB_LOCKFREE */
+}
+
+#ifndef SLAB_LOCKFREE
+
+struct_block**  fn_block_list(struct_slab* slab, struct_block* block) {
+  if (block->free_count == 0) {
+    return &slab->full;
   }
+  if (block->free_count == block->capacity) {
+    return &slab->empty;
+  }
+  return &slab->partial;
+}
+void            fn_block_link(struct_block** list, struct_block* block) {
+  if (list == &block->slab->empty) {
+    block->slab->empty_count++;
+  }
+  block->prev = NULL;
+  block->next = *list;
+  if (*list) {
+    (*list)->prev = block;
+  }
+  *list = block;
+}
+void            fn_block_unlink(struct_block** list, struct_block* block) {
+  if (list == &block->slab->empty) {
+    block->slab->empty_count--;
+  }
+  if (block->prev) {
+    block->prev->next = block->next;
+  } else {
+    *list = block->next;
+  }
+  if (block->next) {
+    block->next->prev = block->prev;
+  }
+  block->prev = NULL;
+  block->next = NULL;
+}
+void            fn_block_move(struct_block* block, struct_block** src) {
+  struct_slab*   slab = block->slab;
+  struct_block** dst  = fn_block_list(slab, block);
+  if (src == dst) {
+    return;
+  }
+
+  fn_block_unlink(src, block);
+  fn_block_link(dst, block);
+
+  #ifdef SLAB_TRIM_AUTO
+    /* Trimming well below the trigger keeps a slab that oscillates around one block from freeing and creating it every time */
+    if (dst == &slab->empty && slab->empty_count > SLAB_TRIM_HIGH) {
+      fn_slab_trim(slab, SLAB_TRIM_LOW);
+    }
+  #endif /* SLAB_TRIM_AUTO */
+}
+
+void            fn_block_push(struct_block* block, SLAB_DATA_TYPE* ptr) {
+  struct_slab*   slab = block->slab;
+  struct_block** src  = fn_block_list(slab, block);
+
+  size_t idx = SLAB_PTR_TO_INDEX(block, ptr);
+  block->allocated_bits[idx >> 6] &= ~SLAB_BIT(idx);
+  SLAB_LINK(block, idx) = block->free_head;
+  block->free_head = (uint32_t)(idx + 1);
+  block->free_count++;
+  slab->total--;
+  SLAB_STATS_FREE(slab, 1);
+
+  fn_block_move(block, src);
+}
+SLAB_DATA_TYPE* fn_block_pop(struct_block* block) {
+  struct_slab*   slab = block->slab;
+  struct_block** src  = fn_block_list(slab, block);
+
+  size_t idx = 0;
+  if (block->free_head) {
+    idx = block->free_head - 1;
+    block->free_head = SLAB_LINK(block, idx);
+  } else {
+    idx = block->bump++;
+    SLAB_BUILD(block, idx);
+  }
+  block->free_count--;
+  block->allocated_bits[idx >> 6] |= SLAB_BIT(idx);
+  slab->total++;
+  SLAB_STATS_ALLOC(slab, 1);
+
+  fn_block_move(block, src);
+  return &block->mem[idx].data;
 }
 
+#else
+
+void            fn_block_push(struct_block* block, SLAB_DATA_TYPE* ptr) {
+  uint32_t idx = (uint32_t)SLAB_PTR_TO_INDEX(block, ptr);
+  uint64_t old = atomic_load_explicit(&block->head, memory_order_relaxed);
+  uint64_t new = 0;
+
+  do {
+    atomic_store_explicit(&SLAB_BLOCK_LINKS(block)[idx], (uint32_t)old, memory_order_relaxed);
+    new = (((old >> 32) + 1) << 32) | (uint64_t)(idx + 1);
+  } while (!atomic_compare_exchange_weak_explicit(&block->head, &old, new, memory_order_release, memory_order_relaxed));
+
+  atomic_fetch_sub_explicit(&block->slab->total, 1, memory_order_relaxed);
+  SLAB_STATS_FREE(block->slab, 1);
+}
+SLAB_DATA_TYPE* fn_block_pop(struct_block* block) {
+  uint64_t old = atomic_load_explicit(&block->head, memory_order_acquire);
+  uint32_t idx = 0;
+
+  while ((uint32_t)old != 0) {
+    /* The link may be stale if another thread popped this object meanwhile, the tag makes the exchange fail in that case */
+    uint32_t next = atomic_load_explicit(&SLAB_BLOCK_LINKS(block)[(uint32_t)old - 1], memory_order_relaxed);
+    uint64_t new  = (((old >> 32) + 1) << 32) | (uint64_t)next;
+    if (atomic_compare_exchange_weak_explicit(&block->head, &old, new, memory_order_acquire, memory_order_acquire)) {
+      idx = (uint32_t)old;
+      break;
+    }
+  }
+
+  if (idx == 0) {
+    uint32_t bump = atomic_load_explicit(&block->bump, memory_order_relaxed);
+    do {
+      if (bump >= block->capacity) {
+        return NULL;
+      }
+    } while (!atomic_compare_exchange_weak_explicit(&block->bump, &bump, bump + 1, memory_order_relaxed, memory_order_relaxed));
+    SLAB_BUILD(block, bump);
+    idx = bump + 1;
+  }
+
+  idx--;
+  atomic_fetch_or_explicit(&block->allocated_bits[idx >> 6], SLAB_BIT(idx), memory_order_relaxed);
+  #ifndef SLAB_STATS
+    atomic_fetch_add_explicit(&block->slab->total, 1, memory_order_relaxed);
+  #else
+    size_t total = atomic_fetch_add_explicit(&block->slab->total, 1, memory_order_relaxed) + 1;
+    SLAB_STATS_ALLOC(block->slab, 1);
+    size_t peak = atomic_load_explicit(&block->slab->peak, memory_order_relaxed);
+    while (peak < total && !atomic_compare_exchange_weak_explicit(&block->slab->peak, &peak, total, memory_order_relaxed, memory_order_relaxed));
+  #endif /* SLAB_STATS */
+
+  return &block->mem[idx].data;
+}
+
+#endif /* SLAB_LOCKFREE */
+
 struct_slab*    fn_slab_create(struct_slab* slab) {
   if (!slab) {
     CALLOC(slab, struct_slab, 1);
@@ -118,20 +701,89 @@ struct_slab*    fn_slab_create(struct_slab* slab) {
 
   RWLOCK_INIT(slab->lock);
 
-  fn_block_create(&slab->block);
+  slab->blocks  = 0;
+  slab->total   = 0;
+
+  #ifdef SLAB_STATS
+    slab->peak    = 0;
+    slab->allocs  = 0;
+    slab->frees   = 0;
+  #endif /* SLAB_STATS */
+
+  #ifndef SLAB_LOCKFREE
+    slab->partial     = NULL;
+    slab->full        = NULL;
+    slab->empty       = NULL;
+    slab->empty_count = 0;
+    fn_block_link(&slab->empty, fn_block_create(slab));
+  #else
+    struct_block* block = fn_block_create(slab);
+    atomic_store_explicit(&slab->block, block, memory_order_release);
+    atomic_store_explicit(&slab->hint, block, memory_order_release);
+  #endif /* SLAB_LOCKFREE */
+
+  #ifdef SLAB_MAGAZINES
+    RWLOCK_INIT(slab->depot_lock);
+    slab->depot_full  = NULL;
+    slab->depot_empty = NULL;
+    slab->caches      = 0;
+  #endif /* SLAB_MAGAZINES */
+
+  #ifdef SLAB_REMOTE_FREE
+    slab->owner = THREAD_ID();
+    atomic_init(&slab->remote, NULL);
+  #endif /* SLAB_REMOTE_FREE */
 
   return slab;
 }
 void            fn_slab_destroy(struct_slab* slab) {
   BLOP_ASSERT_PTR(slab);
 
+  #ifdef SLAB_MAGAZINES
+    fn_slab_cache_flush(slab);
+    fn_slab_cache_purge(slab);
+    BLOP_ASSERT_FORCED(slab->caches == 0, "Trying to free a slab whose objects are still cached by other threads (call cache_flush on each of them)");
+
+    while (slab->depot_empty) {
+      struct_magazine* next = slab->depot_empty->next;
+      FREE(slab->depot_empty);
+      slab->depot_empty = next;
+    }
+    RWLOCK_DESTROY(slab->depot_lock);
+  #endif /* SLAB_MAGAZINES */
+
+  #ifdef SLAB_REMOTE_FREE
+    fn_slab_collect(slab);
+  #endif /* SLAB_REMOTE_FREE */
+
   BLOP_ASSERT_FORCED(slab->total == 0, "Trying to free a non empty slab");
 
-  struct_block* current = &slab->block;
-  while (current) {
-    struct_block* next = current->next;
-    fn_block_destroy(current);
-    current = next;
+  #ifndef SLAB_LOCKFREE
+    struct_block** lists[3] = { &slab->partial, &slab->full, &slab->empty };
+    for (size_t i = 0; i < 3; i++) {
+      struct_block* current = *lists[i];
+      while (current) {
+        struct_block* next = current->next;
+        fn_block_destroy(current);
+        current = next;
+      }
+      *lists[i] = NULL;
+    }
+    slab->empty_count = 0;
+  #else
+    struct_block* current = atomic_exchange(&slab->block, NULL);
+    while (current) {
+      struct_block* next = current->next;
+      fn_block_destroy(current);
+      current = next;
+    }
+    atomic_store(&slab->hint, NULL);
+  #endif /* SLAB_LOCKFREE */
+
+  RWLOCK_DESTROY(slab->lock);
+
+  if (slab->allocated) {
+    FREE(slab);
   }
 }
 
@@ -152,79 +804,652 @@ void            fn_slab_wrunlock(struct_slab* slab) {
   RWLOCK_WRUNLOCK(slab->lock);
 }
 
+struct_block*   fn_slab_block(struct_slab* slab, SLAB_DATA_TYPE* ptr) {
+  BLOP_ASSERT_PTR(slab);
+  BLOP_ASSERT_PTR(ptr);
+
+  struct_block* block = SLAB_PTR_TO_BLOCK(ptr);
+  BLOP_ASSERT_FORCED(block->slab == slab && SLAB_BLOCK_OWNS(block, ptr), "Trying to free a foreign ptr");
+
+  size_t idx = SLAB_PTR_TO_INDEX(block, ptr);
+  BLOP_ASSERT_FORCED(idx < block->bump && (block->allocated_bits[idx >> 6] & SLAB_BIT(idx)), "Ptr belongs to slab but was not allocated");
+
+  return block;
+}
 void            fn_slab_clear(struct_slab* slab) {
   BLOP_ASSERT_PTR(slab);
 
-  struct_block* current = &slab->block;
-  while (current) {
-    #ifdef SLAB_DEALLOCATE_DATA
-      for (size_t i = 0; i < SLAB_OBJECTS_COUNT; i++) {
-        if (current->allocated_list[i]) {
-          SLAB_DEALLOCATE_DATA(&current->mem[i]);
-          current->allocated_list[i] = false;
-        }
+  #ifdef SLAB_MAGAZINES
+    /* Cached objects go back to their blocks first so they are not deallocated twice, only the calling thread and the depot can be reached */
+    struct_magazine* magazines[2 * SLAB_MAGAZINE_SLOTS] = {0};
+    size_t           held = 0;
+    for (size_t i = 0; i < SLAB_MAGAZINE_SLOTS; i++) {
+      if (slab_caches[i].slab == slab) {
+        magazines[2 * i]     = slab_caches[i].loaded;
+        magazines[2 * i + 1] = slab_caches[i].previous;
+        held++;
       }
-    #endif /* SLAB_DEALLOCATE_DATA */
+    }
 
-    memset(current->allocated_list, 0, SLAB_OBJECTS_COUNT);
-    memset(current->mem, 0, SLAB_OBJECTS_COUNT * sizeof(SLAB_DATA_TYPE));
-    current->free_count = SLAB_OBJECTS_COUNT;
-    for (size_t i = 0; i < SLAB_OBJECTS_COUNT; i++) {
-      current->free_list[i] = &current->mem[SLAB_OBJECTS_COUNT - i - 1];
+    RWLOCK_WRLOCK(slab->depot_lock);
+    BLOP_ASSERT_FORCED(slab->caches == held, "Trying to clear a slab whose objects are still cached by other threads (call cache_flush on each of them)");
+    for (struct_magazine* current = slab->depot_full; current; current = current->next) {
+      while (current->rounds) {
+        SLAB_DATA_TYPE* ptr = current->objects[--current->rounds];
+        fn_block_push(fn_slab_block(slab, ptr), ptr);
+      }
+    }
+    while (slab->depot_full) {
+      struct_magazine* full = slab->depot_full;
+      slab->depot_full  = full->next;
+      full->next        = slab->depot_empty;
+      slab->depot_empty = full;
     }
+    RWLOCK_WRUNLOCK(slab->depot_lock);
 
-    struct_block* next = current->next;
-    fn_block_destroy(current);
-    current = next;
-  }
+    for (size_t i = 0; i < 2 * SLAB_MAGAZINE_SLOTS; i++) {
+      while (magazines[i] && magazines[i]->rounds) {
+        SLAB_DATA_TYPE* ptr = magazines[i]->objects[--magazines[i]->rounds];
+        fn_block_push(fn_slab_block(slab, ptr), ptr);
+      }
+    }
+  #endif /* SLAB_MAGAZINES */
+
+  /* Queued remote frees were already deallocated by their freeing threads and their first bytes hold the queue link, they go back first so clearing the blocks does not deallocate them again */
+  #ifdef SLAB_REMOTE_FREE
+    fn_slab_collect(slab);
+  #endif /* SLAB_REMOTE_FREE */
+
+  #ifndef SLAB_LOCKFREE
+    struct_block** lists[2] = { &slab->partial, &slab->full };
+    for (size_t i = 0; i < 2; i++) {
+      while (*lists[i]) {
+        struct_block* current = *lists[i];
+        fn_block_unlink(lists[i], current);
+        fn_block_clear(current);
+        fn_block_link(&slab->empty, current);
+      }
+    }
+  #else
+    /* Not safe against concurrent alloc/free, the caller must make sure no other thread is using the slab */
+    for (struct_block* current = atomic_load(&slab->block); current; current = current->next) {
+      fn_block_clear(current);
+    }
+  #endif /* SLAB_LOCKFREE */
+
+  SLAB_STATS_FREE(slab, slab->total);
+  slab->total = 0;
 }
-void            fn_slab_free(struct_slab* slab, SLAB_DATA_TYPE* ptr) {
+void            fn_slab_reset(struct_slab* slab) {
   BLOP_ASSERT_PTR(slab);
-  BLOP_ASSERT_PTR(ptr);
 
-  struct_block* current = &slab->block;
-  while (current) {
-    if (ptr >= &current->mem[0] && ptr <= &current->mem[SLAB_OBJECTS_COUNT - 1]) {
-      BLOP_ASSERT_FORCED(current->allocated_list[(size_t)(ptr - current->mem)], "Ptr belongs to slab but was not allocated");
+  /* Like clear but without visiting live objects, every block is just rewound to its bump index */
+  #ifdef SLAB_MAGAZINES
+    size_t held = 0;
+    for (size_t i = 0; i < SLAB_MAGAZINE_SLOTS; i++) {
+      if (slab_caches[i].slab == slab) {
+        slab_caches[i].loaded->rounds   = 0;
+        slab_caches[i].previous->rounds = 0;
+        held++;
+      }
+    }
+
+    RWLOCK_WRLOCK(slab->depot_lock);
+    BLOP_ASSERT_FORCED(slab->caches == held, "Trying to reset a slab whose objects are still cached by other threads (call cache_flush on each of them)");
+    while (slab->depot_full) {
+      struct_magazine* full = slab->depot_full;
+      slab->depot_full  = full->next;
+      full->rounds      = 0;
+      full->next        = slab->depot_empty;
+      slab->depot_empty = full;
+    }
+    RWLOCK_WRUNLOCK(slab->depot_lock);
+  #endif /* SLAB_MAGAZINES */
+
+  #ifdef SLAB_REMOTE_FREE
+    atomic_store_explicit(&slab->remote, NULL, memory_order_relaxed);
+  #endif /* SLAB_REMOTE_FREE */
 
+  #ifndef SLAB_LOCKFREE
+    struct_block** lists[2] = { &slab->partial, &slab->full };
+    for (size_t i = 0; i < 2; i++) {
+      while (*lists[i]) {
+        struct_block* current = *lists[i];
+        fn_block_unlink(lists[i], current);
+        fn_block_reset(current);
+        fn_block_link(&slab->empty, current);
+      }
+    }
+  #else
+    /* Not safe against concurrent alloc/free, the caller must make sure no other thread is using the slab */
+    for (struct_block* current = atomic_load(&slab->block); current; current = current->next) {
+      fn_block_reset(current);
+    }
+  #endif /* SLAB_LOCKFREE */
+
+  SLAB_STATS_FREE(slab, slab->total);
+  slab->total = 0;
+}
+size_t          fn_slab_trim(struct_slab* slab, size_t spares) {
+  BLOP_ASSERT_PTR(slab);
+
+  size_t freed = 0;
+
+  #ifdef SLAB_REMOTE_FREE
+    fn_slab_collect(slab);
+  #endif /* SLAB_REMOTE_FREE */
+
+  #ifndef SLAB_LOCKFREE
+    while (slab->empty_count > spares) {
+      struct_block* block = slab->empty;
+      fn_block_unlink(&slab->empty, block);
+      freed += SLAB_BLOCK_BYTES(block->capacity);
+      fn_block_destroy(block);
+    }
+  #else
+    /* Not safe against concurrent alloc/free, the caller must make sure no other thread is using the slab.
+     * The head block is always kept so alloc has somewhere to start from */
+    struct_block* head = atomic_load(&slab->block);
+    struct_block* prev = head;
+    for (struct_block* current = head->next; current; current = prev->next) {
+      int empty = 1;
+      size_t words = ((size_t)atomic_load(&current->bump) + 63) / 64;
+      for (size_t i = 0; i < words && empty; i++) {
+        empty = atomic_load(&current->allocated_bits[i]) == 0;
+      }
+
+      if (!empty || spares) {
+        spares -= empty;
+        prev = current;
+        continue;
+      }
+
+      prev->next = current->next;
+      freed += SLAB_BLOCK_BYTES(current->capacity);
+      fn_block_destroy(current);
+    }
+    atomic_store(&slab->hint, head);
+  #endif /* SLAB_LOCKFREE */
+
+  return freed;
+}
+void            fn_slab_free(struct_slab* slab, SLAB_DATA_TYPE* ptr) {
+  #ifdef SLAB_REMOTE_FREE
+    BLOP_ASSERT_PTR(slab);
+    BLOP_ASSERT_PTR(ptr);
+
+    /* Only the immutable block header is checked here, the owner validates the object when it collects it */
+    if (THREAD_ID() != slab->owner) {
+      struct_block* owner = SLAB_PTR_TO_BLOCK(ptr);
+      BLOP_ASSERT_FORCED(owner->slab == slab && SLAB_BLOCK_OWNS(owner, ptr), "Trying to free a foreign ptr");
+
+      /* The queue link overwrites the start of the object, so its data is released before the object is queued */
       #ifdef SLAB_DEALLOCATE_DATA
         SLAB_DEALLOCATE_DATA(ptr);
       #endif /* SLAB_DEALLOCATE_DATA */
 
-      current->allocated_list[(size_t)(ptr - current->mem)] = false;
-      current->free_list[current->free_count] = ptr;
-      current->free_count++;
-      slab->total--;
+      struct_slot* slot = (struct_slot*)ptr;
+      struct_slot* head = atomic_load_explicit(&slab->remote, memory_order_relaxed);
+      do {
+        slot->remote = head;
+      } while (!atomic_compare_exchange_weak_explicit(&slab->remote, &head, slot, memory_order_release, memory_order_relaxed));
       return;
     }
+  #endif /* SLAB_REMOTE_FREE */
 
-    current = current->next;
-  }
+  struct_block* block = fn_slab_block(slab, ptr);
 
-  BLOP_ASSERT_FORCED(false, "Trying to free a foreign ptr");
+  #ifdef SLAB_LOCKFREE
+    /* Two racing frees of the same ptr can both pass fn_slab_block, only one of them wins the exchange */
+    size_t idx = SLAB_PTR_TO_INDEX(block, ptr);
+    uint64_t bits = atomic_fetch_and_explicit(&block->allocated_bits[idx >> 6], ~SLAB_BIT(idx), memory_order_relaxed);
+    BLOP_ASSERT_FORCED(bits & SLAB_BIT(idx), "Ptr belongs to slab but was not allocated");
+  #endif /* SLAB_LOCKFREE */
+
+  #ifdef SLAB_DEALLOCATE_DATA
+    SLAB_DEALLOCATE_DATA(ptr);
+  #endif /* SLAB_DEALLOCATE_DATA */
+
+  fn_block_push(block, ptr);
 }
 SLAB_DATA_TYPE* fn_slab_alloc(struct_slab* slab) {
   BLOP_ASSERT_PTR(slab);
 
-  struct_block* current = &slab->block;
-  while (current) {
-    if (current->free_count > 0) {
-      slab->total++;
-      current->free_count--;
-      SLAB_DATA_TYPE* ptr = current->free_list[current->free_count];
-      current->allocated_list[(size_t)(ptr - current->mem)] = true;
+  #ifdef SLAB_REMOTE_FREE
+    if (atomic_load_explicit(&slab->remote, memory_order_relaxed)) {
+      fn_slab_collect(slab);
+    }
+  #endif /* SLAB_REMOTE_FREE */
+
+  #ifndef SLAB_LOCKFREE
+    struct_block* block = slab->partial;
+    if (!block) {
+      block = slab->empty;
+      if (!block) {
+        block = fn_block_create(slab);
+        fn_block_link(&slab->empty, block);
+      }
+    }
+
+    return fn_block_pop(block);
+  #else
+    SLAB_DATA_TYPE* ptr = fn_block_pop(atomic_load_explicit(&slab->hint, memory_order_acquire));
+    if (ptr) {
       return ptr;
     }
 
-    if (current->next == NULL) {
-      current->next = fn_block_create(NULL);
+    for (struct_block* current = atomic_load_explicit(&slab->block, memory_order_acquire); current; current = current->next) {
+      ptr = fn_block_pop(current);
+      if (ptr) {
+        atomic_store_explicit(&slab->hint, current, memory_order_release);
+        return ptr;
+      }
+    }
+
+    /* Every published block is exhausted, take the first object privately and then publish the block */
+    struct_block* block = fn_block_create(slab);
+    ptr = fn_block_pop(block);
+
+    struct_block* head = atomic_load_explicit(&slab->block, memory_order_relaxed);
+    do {
+      block->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&slab->block, &head, block, memory_order_release, memory_order_relaxed));
+    atomic_store_explicit(&slab->hint, block, memory_order_release);
+
+    return ptr;
+  #endif /* SLAB_LOCKFREE */
+}
+
+void            fn_slab_free_n(struct_slab* slab, SLAB_DATA_TYPE** ptrs, size_t count) {
+  BLOP_ASSERT_PTR(slab);
+  BLOP_ASSERT_PTR(ptrs);
+
+  #ifdef SLAB_REMOTE_FREE
+    /* The whole batch is chained first and queued with a single CAS */
+    if (THREAD_ID() != slab->owner) {
+      if (count == 0) {
+        return;
+      }
+
+      for (size_t i = 0; i < count; i++) {
+        struct_block* owner = SLAB_PTR_TO_BLOCK(ptrs[i]);
+        BLOP_ASSERT_FORCED(ptrs[i] && owner->slab == slab && SLAB_BLOCK_OWNS(owner, ptrs[i]), "Trying to free a foreign ptr");
+        #ifdef SLAB_DEALLOCATE_DATA
+          SLAB_DEALLOCATE_DATA(ptrs[i]);
+        #endif /* SLAB_DEALLOCATE_DATA */
+        ((struct_slot*)ptrs[i])->remote = (i + 1 < count) ? (struct_slot*)ptrs[i + 1] : NULL;
+      }
+
+      struct_slot* last = (struct_slot*)ptrs[count - 1];
+      struct_slot* head = atomic_load_explicit(&slab->remote, memory_order_relaxed);
+      do {
+        last->remote = head;
+      } while (!atomic_compare_exchange_weak_explicit(&slab->remote, &head, (struct_slot*)ptrs[0], memory_order_release, memory_order_relaxed));
+      return;
     }
-    current = current->next;
+  #endif /* SLAB_REMOTE_FREE */
+
+  #ifndef SLAB_LOCKFREE
+    /* Runs of objects from the same block only move that block between lists once */
+    struct_block*  block = NULL;
+    struct_block** src   = NULL;
+    for (size_t i = 0; i < count; i++) {
+      SLAB_DATA_TYPE* ptr   = ptrs[i];
+      struct_block*   owner = fn_slab_block(slab, ptr);
+      if (owner != block) {
+        if (block) {
+          fn_block_move(block, src);
+        }
+        block = owner;
+        src   = fn_block_list(slab, block);
+      }
+
+      #ifdef SLAB_DEALLOCATE_DATA
+        SLAB_DEALLOCATE_DATA(ptr);
+      #endif /* SLAB_DEALLOCATE_DATA */
+
+      size_t idx = SLAB_PTR_TO_INDEX(block, ptr);
+      block->allocated_bits[idx >> 6] &= ~SLAB_BIT(idx);
+      SLAB_LINK(block, idx) = block->free_head;
+      block->free_head = (uint32_t)(idx + 1);
+      block->free_count++;
+    }
+    slab->total -= count;
+    SLAB_STATS_FREE(slab, count);
+
+    if (block) {
+      fn_block_move(block, src);
+    }
+  #else
+    for (size_t i = 0; i < count; i++) {
+      fn_slab_free(slab, ptrs[i]);
+    }
+  #endif /* SLAB_LOCKFREE */
+}
+void            fn_slab_alloc_n(struct_slab* slab, SLAB_DATA_TYPE** out, size_t count) {
+  BLOP_ASSERT_PTR(slab);
+  BLOP_ASSERT_PTR(out);
+
+  #ifdef SLAB_REMOTE_FREE
+    if (atomic_load_explicit(&slab->remote, memory_order_relaxed)) {
+      fn_slab_collect(slab);
+    }
+  #endif /* SLAB_REMOTE_FREE */
+
+  #ifndef SLAB_LOCKFREE
+    size_t done = 0;
+    while (done < count) {
+      struct_block* block = slab->partial;
+      if (!block) {
+        block = slab->empty;
+        if (!block) {
+          block = fn_block_create(slab);
+          fn_block_link(&slab->empty, block);
+        }
+      }
+
+      struct_block** src  = fn_block_list(slab, block);
+      size_t         take = MIN(count - done, block->free_count);
+      size_t         i    = 0;
+
+      for (; i < take && block->free_head; i++) {
+        size_t idx = block->free_head - 1;
+        block->free_head = SLAB_LINK(block, idx);
+        block->allocated_bits[idx >> 6] |= SLAB_BIT(idx);
+        out[done + i] = &block->mem[idx].data;
+      }
+
+      /* The rest comes from the untouched tail of the block, its bits are set a word at a time */
+      size_t first = block->bump;
+      size_t last  = first + (take - i);
+      for (size_t idx = first; idx < last; idx++) {
+        SLAB_BUILD(block, idx);
+        out[done + i++] = &block->mem[idx].data;
+      }
+      block->bump = (uint32_t)last;
+      while (first < last) {
+        size_t   bits = MIN(64 - (first & 63), last - first);
+        uint64_t mask = (bits == 64) ? ~(uint64_t)0 : (((uint64_t)1 << bits) - 1) << (first & 63);
+        block->allocated_bits[first >> 6] |= mask;
+        first += bits;
+      }
+
+      block->free_count -= take;
+      slab->total       += take;
+      done              += take;
+      SLAB_STATS_ALLOC(slab, take);
+      fn_block_move(block, src);
+    }
+  #else
+    for (size_t i = 0; i < count; i++) {
+      out[i] = fn_slab_alloc(slab);
+    }
+  #endif /* SLAB_LOCKFREE */
+}
+void            fn_slab_foreach(struct_slab* slab, type_slab_foreach fn, void* ctx) {
+  BLOP_ASSERT_PTR(slab);
+  BLOP_ASSERT_PTR(fn);
+
+  /* Queued remote frees are collected first so they are not visited, objects cached in magazines are still allocated as far as the blocks know, so they are visited too */
+  #ifdef SLAB_REMOTE_FREE
+    fn_slab_collect(slab);
+  #endif /* SLAB_REMOTE_FREE */
+
+  #ifndef SLAB_LOCKFREE
+    struct_block* lists[2] = { slab->partial, slab->full };
+    for (size_t l = 0; l < 2; l++) {
+      for (struct_block* current = lists[l]; current; current = current->next) {
+        size_t words = ((size_t)current->bump + 63) / 64;
+        for (size_t i = 0; i < words; i++) {
+          uint64_t bits = current->allocated_bits[i];
+          while (bits) {
+            fn(&current->mem[i * 64 + (size_t)blop_ctz64(bits)].data, ctx);
+            bits &= bits - 1;
+          }
+        }
+      }
+    }
+  #else
+    /* Not safe against concurrent alloc/free, the caller must make sure no other thread is using the slab */
+    for (struct_block* current = atomic_load(&slab->block); current; current = current->next) {
+      size_t words = ((size_t)atomic_load(&current->bump) + 63) / 64;
+      for (size_t i = 0; i < words; i++) {
+        uint64_t bits = atomic_load_explicit(&current->allocated_bits[i], memory_order_relaxed);
+        while (bits) {
+          fn(&current->mem[i * 64 + (size_t)blop_ctz64(bits)].data, ctx);
+          bits &= bits - 1;
+        }
+      }
+    }
+  #endif /* SLAB_LOCKFREE */
+}
+
+#ifdef SLAB_REMOTE_FREE
+
+void            fn_slab_adopt(struct_slab* slab) {
+  BLOP_ASSERT_PTR(slab);
+
+  /* Hand the slab to the calling thread, no other thread may be freeing into it while it changes hands */
+  slab->owner = THREAD_ID();
+}
+size_t          fn_slab_collect(struct_slab* slab) {
+  BLOP_ASSERT_PTR(slab);
+
+  /* Taking the whole queue at once leaves nothing for an ABA to hit. The freeing threads already ran SLAB_DEALLOCATE_DATA */
+  struct_slot* current = atomic_exchange_explicit(&slab->remote, NULL, memory_order_acquire);
+  size_t       count   = 0;
+  while (current) {
+    struct_slot*    next = current->remote;
+    SLAB_DATA_TYPE* ptr  = &current->data;
+
+    fn_block_push(fn_slab_block(slab, ptr), ptr);
+
+    current = next;
+    count++;
   }
 
-  return NULL; /* Never reaching here */
+  return count;
 }
 
+#endif /* SLAB_REMOTE_FREE */
+
+#ifdef SLAB_MAGAZINES
+
+static struct_magazine* fn_magazine_create(void) {
+  struct_magazine* magazine = NULL;
+  CALLOC(magazine, struct_magazine, 1);
+  return magazine;
+}
+
+struct_cache*   fn_slab_cache(struct_slab* slab) {
+  struct_cache* caches = slab_caches;
+  struct_cache* unused = NULL;
+
+  for (size_t i = 0; i < SLAB_MAGAZINE_SLOTS; i++) {
+    if (caches[i].slab == slab) {
+      return &caches[i];
+    }
+    if (!unused && caches[i].slab == NULL) {
+      unused = &caches[i];
+    }
+  }
+
+  /* Counted so clear, reset and destroy can tell when another thread still holds cached objects */
+  if (unused) {
+    unused->slab     = slab;
+    unused->loaded   = fn_magazine_create();
+    unused->previous = fn_magazine_create();
+
+    RWLOCK_WRLOCK(slab->depot_lock);
+    slab->caches++;
+    RWLOCK_WRUNLOCK(slab->depot_lock);
+  }
+
+  return unused;
+}
+void            fn_slab_cache_free(struct_slab* slab, SLAB_DATA_TYPE* ptr) {
+  BLOP_ASSERT_PTR(slab);
+  BLOP_ASSERT_PTR(ptr);
+
+  struct_block* block = SLAB_PTR_TO_BLOCK(ptr);
+  BLOP_ASSERT_FORCED(block->slab == slab && SLAB_BLOCK_OWNS(block, ptr), "Trying to free a foreign ptr");
+
+  struct_cache* cache = fn_slab_cache(slab);
+  if (!cache) {
+    RWLOCK_WRLOCK(slab->lock);
+    fn_slab_free(slab, ptr);
+    RWLOCK_WRUNLOCK(slab->lock);
+    return;
+  }
+
+  /* Cached objects still look allocated to their block, so only this thread's magazines can tell a double free right away.
+   * Objects freed twice across threads are caught by fn_slab_block when the magazines go back to the blocks */
+  #ifndef DISABLE_BLOP_ASSERTIONS
+    struct_magazine* magazines[2] = { cache->loaded, cache->previous };
+    for (size_t i = 0; i < 2; i++) {
+      for (size_t j = 0; j < magazines[i]->rounds; j++) {
+        BLOP_ASSERT_FORCED(magazines[i]->objects[j] != ptr, "Ptr belongs to slab but was not allocated");
+      }
+    }
+  #endif /* DISABLE_BLOP_ASSERTIONS */
+
+  #ifdef SLAB_DEALLOCATE_DATA
+    SLAB_DEALLOCATE_DATA(ptr);
+  #endif /* SLAB_DEALLOCATE_DATA */
+
+  if (cache->loaded->rounds == SLAB_MAGAZINE_SIZE) {
+    if (cache->previous->rounds == 0) {
+      struct_magazine* tmp = cache->loaded;
+      cache->loaded   = cache->previous;
+      cache->previous = tmp;
+    } else {
+      RWLOCK_WRLOCK(slab->depot_lock);
+      struct_magazine* empty = slab->depot_empty;
+      if (empty) {
+        slab->depot_empty = empty->next;
+      }
+      cache->previous->next = slab->depot_full;
+      slab->depot_full = cache->previous;
+      RWLOCK_WRUNLOCK(slab->depot_lock);
+
+      if (!empty) {
+        empty = fn_magazine_create();
+      }
+      cache->previous = cache->loaded;
+      cache->loaded   = empty;
+    }
+  }
+
+  cache->loaded->objects[cache->loaded->rounds++] = ptr;
+}
+SLAB_DATA_TYPE* fn_slab_cache_alloc(struct_slab* slab) {
+  BLOP_ASSERT_PTR(slab);
+
+  struct_cache* cache = fn_slab_cache(slab);
+  if (!cache) {
+    RWLOCK_WRLOCK(slab->lock);
+    SLAB_DATA_TYPE* ptr = fn_slab_alloc(slab);
+    RWLOCK_WRUNLOCK(slab->lock);
+    return ptr;
+  }
+
+  if (cache->loaded->rounds == 0) {
+    if (cache->previous->rounds != 0) {
+      struct_magazine* tmp = cache->loaded;
+      cache->loaded   = cache->previous;
+      cache->previous = tmp;
+    } else {
+      RWLOCK_WRLOCK(slab->depot_lock);
+      struct_magazine* full = slab->depot_full;
+      if (full) {
+        slab->depot_full = full->next;
+        cache->previous->next = slab->depot_empty;
+        slab->depot_empty = cache->previous;
+      }
+      RWLOCK_WRUNLOCK(slab->depot_lock);
+
+      if (full) {
+        cache->previous = cache->loaded;
+        cache->loaded   = full;
+      } else {
+        /* The depot ran dry, refill the whole magazine from the blocks in a single lock round trip */
+        RWLOCK_WRLOCK(slab->lock);
+        while (cache->loaded->rounds < SLAB_MAGAZINE_SIZE) {
+          cache->loaded->objects[cache->loaded->rounds++] = fn_slab_alloc(slab);
+        }
+        RWLOCK_WRUNLOCK(slab->lock);
+      }
+    }
+  }
+
+  return cache->loaded->objects[--cache->loaded->rounds];
+}
+void            fn_slab_cache_flush(struct_slab* slab) {
+  BLOP_ASSERT_PTR(slab);
+
+  struct_cache* caches = slab_caches;
+  for (size_t i = 0; i < SLAB_MAGAZINE_SLOTS; i++) {
+    if (caches[i].slab != slab) {
+      continue;
+    }
+
+    struct_magazine* magazines[2] = { caches[i].loaded, caches[i].previous };
+
+    RWLOCK_WRLOCK(slab->lock);
+    for (size_t j = 0; j < 2; j++) {
+      while (magazines[j]->rounds) {
+        SLAB_DATA_TYPE* ptr = magazines[j]->objects[--magazines[j]->rounds];
+        fn_block_push(fn_slab_block(slab, ptr), ptr);
+      }
+    }
+    RWLOCK_WRUNLOCK(slab->lock);
+
+    RWLOCK_WRLOCK(slab->depot_lock);
+    for (size_t j = 0; j < 2; j++) {
+      magazines[j]->next = slab->depot_empty;
+      slab->depot_empty = magazines[j];
+    }
+    slab->caches--;
+    RWLOCK_WRUNLOCK(slab->depot_lock);
+
+    caches[i].slab     = NULL;
+    caches[i].loaded   = NULL;
+    caches[i].previous = NULL;
+  }
+}
+void            fn_slab_cache_purge(struct_slab* slab) {
+  BLOP_ASSERT_PTR(slab);
+
+  RWLOCK_WRLOCK(slab->depot_lock);
+  struct_magazine* full = slab->depot_full;
+  slab->depot_full = NULL;
+  RWLOCK_WRUNLOCK(slab->depot_lock);
+
+  if (!full) {
+    return;
+  }
+
+  RWLOCK_WRLOCK(slab->lock);
+  for (struct_magazine* current = full; current; current = current->next) {
+    while (current->rounds) {
+      SLAB_DATA_TYPE* ptr = current->objects[--current->rounds];
+      fn_block_push(fn_slab_block(slab, ptr), ptr);
+    }
+  }
+  RWLOCK_WRUNLOCK(slab->lock);
+
+  RWLOCK_WRLOCK(slab->depot_lock);
+  while (full) {
+    struct_magazine* next = full->next;
+    full->next = slab->depot_empty;
+    slab->depot_empty = full;
+    full = next;
+  }
+  RWLOCK_WRUNLOCK(slab->depot_lock);
+}
+
+#endif /* SLAB_MAGAZINES */
+
 size_t          fn_slab_size(struct_slab* slab) {
   BLOP_ASSERT_PTR(slab);
   return slab->total;
@@ -238,6 +1463,70 @@ void            fn_slab_print_err(struct_slab* slab) {
   LOG_STDERR("Slab Information:\n Allocated " STR(SLAB_DATA_TYPE) "('s): %zu\n Total bytes allocated: %zu\n\n", slab->total, slab->total * sizeof(SLAB_DATA_TYPE));
 }
 
+#ifdef SLAB_STATS
+
+void            fn_slab_stats(struct_slab* slab, struct_stats* stats) {
+  BLOP_ASSERT_PTR(slab);
+  BLOP_ASSERT_PTR(stats);
+
+  memset(stats, 0, sizeof(struct struct_stats));
+  stats->live   = slab->total;
+  stats->peak   = slab->peak;
+  stats->allocs = slab->allocs;
+  stats->frees  = slab->frees;
+
+  #ifndef SLAB_LOCKFREE
+    struct_block* lists[3] = { slab->partial, slab->full, slab->empty };
+    for (size_t l = 0; l < 3; l++) {
+      for (struct_block* current = lists[l]; current; current = current->next) {
+        size_t live = current->capacity - current->free_count;
+        stats->histogram[live ? 1 + (live - 1) * SLAB_STATS_BUCKETS / current->capacity : 0]++;
+        stats->blocks++;
+        stats->block_bytes  += SLAB_BLOCK_BYTES(current->capacity);
+        stats->capacity     += current->capacity;
+        stats->capacity_min  = stats->capacity_min ? MIN(stats->capacity_min, (size_t)current->capacity) : current->capacity;
+        stats->capacity_max  = MAX(stats->capacity_max, (size_t)current->capacity);
+      }
+    }
+  #else
+    /* Only a snapshot while other threads keep allocating */
+    for (struct_block* current = atomic_load(&slab->block); current; current = current->next) {
+      size_t live = 0;
+      for (size_t i = 0; i < SLAB_BITMAP_WORDS; i++) {
+        live += (size_t)blop_popcount64(atomic_load_explicit(&current->allocated_bits[i], memory_order_relaxed));
+      }
+      stats->histogram[live ? 1 + (live - 1) * SLAB_STATS_BUCKETS / current->capacity : 0]++;
+      stats->blocks++;
+      stats->block_bytes  += SLAB_BLOCK_BYTES(current->capacity);
+      stats->capacity     += current->capacity;
+      stats->capacity_min  = stats->capacity_min ? MIN(stats->capacity_min, (size_t)current->capacity) : current->capacity;
+      stats->capacity_max  = MAX(stats->capacity_max, (size_t)current->capacity);
+    }
+  #endif /* SLAB_LOCKFREE */
+}
+void            fn_slab_dump_out(struct_slab* slab) {
+  struct_stats stats;
+  fn_slab_stats(slab, &stats);
+
+  LOG_STDOUT("slab=%s blocks=%zu block_bytes=%zu capacity=%zu capacity_min=%zu capacity_max=%zu live=%zu peak=%zu allocs=%zu frees=%zu histogram=",
+    STR(SLAB_NAME), stats.blocks, stats.block_bytes, stats.capacity, stats.capacity_min, stats.capacity_max, stats.live, stats.peak, stats.allocs, stats.frees);
+  for (size_t i = 0; i <= SLAB_STATS_BUCKETS; i++) {
+    LOG_STDOUT("%zu%s", stats.histogram[i], i < SLAB_STATS_BUCKETS ? "," : "\n");
+  }
+}
+void            fn_slab_dump_err(struct_slab* slab) {
+  struct_stats stats;
+  fn_slab_stats(slab, &stats);
+
+  LOG_STDERR("slab=%s blocks=%zu block_bytes=%zu capacity=%zu capacity_min=%zu capacity_max=%zu live=%zu peak=%zu allocs=%zu frees=%zu histogram=",
+    STR(SLAB_NAME), stats.blocks, stats.block_bytes, stats.capacity, stats.capacity_min, stats.capacity_max, stats.live, stats.peak, stats.allocs, stats.frees);
+  for (size_t i = 0; i <= SLAB_STATS_BUCKETS; i++) {
+    LOG_STDERR("%zu%s", stats.histogram[i], i < SLAB_STATS_BUCKETS ? "," : "\n");
+  }
+}
+
+#endif /* SLAB_STATS */
+
 #endif /* SLAB_IMPLEMENTATION */
 
 #ifdef __cplusplus
@@ -249,12 +1538,66 @@ void            fn_slab_print_err(struct_slab* slab) {
 
 #undef SLAB_DATA_TYPE
 #undef SLAB_OBJECTS_COUNT
+#undef SLAB_OBJECTS_MIN
+#undef SLAB_BLOCK_BYTES
+#undef SLAB_BLOCK_LINKS
+#undef SLAB_LINK
+#undef SLAB_BUILT
+#undef SLAB_BUILD
+#undef SLAB_CACHED
+#undef SLAB_CONSTRUCT
+#undef SLAB_DESTRUCT
+#undef SLAB_BLOCK_ALIGN
+#undef SLAB_BLOCK_ALIGN_MAX
+#undef SLAB_BLOCK_CAPACITY
+#undef SLAB_DEALLOCATE_DATA
+#undef SLAB_BITMAP_WORDS
+#undef SLAB_ALIGNMENT
+#undef SLAB_PAD_TO_CACHELINE
+#undef SLAB_BLOCK_ALLOC
+#undef SLAB_BLOCK_FREE
+#undef SLAB_PTR_TO_BLOCK
+#undef SLAB_PTR_TO_INDEX
+#undef SLAB_BLOCK_OWNS
+#undef SLAB_BIT
+#undef SLAB_STATS_ALLOC
+#undef SLAB_STATS_FREE
+
+#undef SLAB_LOCKFREE
+#undef SLAB_REMOTE_FREE
+#undef SLAB_MAGAZINES
+#undef SLAB_MAGAZINE_SIZE
+#undef SLAB_MAGAZINE_SLOTS
+#undef SLAB_TRIM_AUTO
+#undef SLAB_TRIM_LOW
+#undef SLAB_TRIM_HIGH
+#undef SLAB_STATS
+#undef SLAB_STATS_BUCKETS
 
 #undef SLAB_STRUCT
 #undef SLAB_NOT_STRUCT
 #undef SLAB_IMPLEMENTATION
 
 #undef struct_slab
+#undef struct_block
+#undef struct_slot
+#undef struct_magazine
+#undef struct_cache
+#undef struct_stats
+
+#undef fn_block_create
+#undef fn_block_destroy
+#undef fn_block_clear
+#undef fn_block_reset
+#undef fn_block_list
+#undef fn_block_link
+#undef fn_block_unlink
+#undef fn_block_move
+#undef fn_block_push
+#undef fn_block_pop
+
+#undef fn_magazine_create
+#undef slab_caches
 
 #undef fn_slab_create
 #undef fn_slab_destroy
@@ -264,10 +1607,29 @@ void            fn_slab_print_err(struct_slab* slab) {
 #undef fn_slab_rdunlock
 #undef fn_slab_wrunlock
 
+#undef fn_slab_block
 #undef fn_slab_clear
+#undef fn_slab_reset
+#undef fn_slab_trim
 #undef fn_slab_free
 #undef fn_slab_alloc
+#undef fn_slab_free_n
+#undef fn_slab_alloc_n
+#undef fn_slab_foreach
+#undef type_slab_foreach
+
+#undef fn_slab_adopt
+#undef fn_slab_collect
+
+#undef fn_slab_cache
+#undef fn_slab_cache_free
+#undef fn_slab_cache_alloc
+#undef fn_slab_cache_flush
+#undef fn_slab_cache_purge
 
 #undef fn_slab_size
 #undef fn_slab_print_out
-#undef fn_slab_print_err
\ No newline at end of file
+#undef fn_slab_print_err
+#undef fn_slab_stats
+#undef fn_slab_dump_out
+#undef fn_slab_dump_err
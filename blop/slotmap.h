@@ -0,0 +1,359 @@
+#include <blop/blop.h>
+
+#ifndef SLOTMAP_NAME
+  #define SLOTMAP_NAME Slotmap_int
+#endif /* SLOTMAP_NAME */
+
+#ifndef SLOTMAP_FN_PREFIX
+  #define SLOTMAP_FN_PREFIX SLOTMAP_NAME
+#endif /* SLOTMAP_FN_PREFIX */
+
+#ifndef SLOTMAP_DATA_TYPE
+  #define SLOTMAP_DATA_TYPE int
+#endif /* SLOTMAP_DATA_TYPE */
+
+#if !defined(SLOTMAP_INITIAL_SIZE) || SLOTMAP_INITIAL_SIZE <= 0
+  #define SLOTMAP_INITIAL_SIZE 16
+#endif /* SLOTMAP_INITIAL_SIZE */
+
+/* Handles are 32 bits by default, SLOTMAP_HANDLE_64 makes them 64 bits (32 bits of index and 32 of generation) */
+#ifdef SLOTMAP_HANDLE_64
+  #define SLOTMAP_HANDLE_TYPE uint64_t
+  #define SLOTMAP_HANDLE_BITS 64
+  #ifndef SLOTMAP_INDEX_BITS
+    #define SLOTMAP_INDEX_BITS 32
+  #endif /* SLOTMAP_INDEX_BITS */
+#else
+  #define SLOTMAP_HANDLE_TYPE uint32_t
+  #define SLOTMAP_HANDLE_BITS 32
+  #ifndef SLOTMAP_INDEX_BITS
+    #define SLOTMAP_INDEX_BITS 20
+  #endif /* SLOTMAP_INDEX_BITS */
+#endif /* SLOTMAP_HANDLE_64 */
+
+#if SLOTMAP_INDEX_BITS > 32 || SLOTMAP_HANDLE_BITS - SLOTMAP_INDEX_BITS < 2 || SLOTMAP_HANDLE_BITS - SLOTMAP_INDEX_BITS > 32
+  #error "SLOTMAP_INDEX_BITS must leave between 2 and 32 generation bits and can not exceed 32"
+#endif
+
+#define SLOTMAP_GENERATION_BITS (SLOTMAP_HANDLE_BITS - SLOTMAP_INDEX_BITS)
+#define SLOTMAP_INDEX_MASK      ((uint32_t)(((uint64_t)1 << SLOTMAP_INDEX_BITS) - 1))
+#define SLOTMAP_GENERATION_MASK ((uint32_t)(((uint64_t)1 << SLOTMAP_GENERATION_BITS) - 1))
+/* With 32 index bits the last index is left out, it is the SLOTMAP_NO_SLOT sentinel of the free list */
+#define SLOTMAP_SLOTS_MAX       ((size_t)SLOTMAP_INDEX_MASK + (SLOTMAP_INDEX_BITS < 32))
+#define SLOTMAP_NO_SLOT         UINT32_MAX
+
+#define SLOTMAP_HANDLE(index, generation) ((SLOTMAP_HANDLE_TYPE)(generation) << SLOTMAP_INDEX_BITS | (SLOTMAP_HANDLE_TYPE)(index))
+#define SLOTMAP_HANDLE_INDEX(handle)      ((uint32_t)(handle) & SLOTMAP_INDEX_MASK)
+#define SLOTMAP_HANDLE_GENERATION(handle) ((uint32_t)((handle) >> SLOTMAP_INDEX_BITS))
+
+/** @cond doxygen_ignore */
+#define struct_slotmap        SLOTMAP_NAME
+#define struct_slot           CONCAT2(SLOTMAP_NAME, _slot)
+#define type_handle           CONCAT2(SLOTMAP_NAME, _handle)
+
+#define fn_slotmap_create     CONCAT2(SLOTMAP_FN_PREFIX, _create)
+#define fn_slotmap_destroy    CONCAT2(SLOTMAP_FN_PREFIX, _destroy)
+
+#define fn_slotmap_rdlock     CONCAT2(SLOTMAP_FN_PREFIX, _rdlock)
+#define fn_slotmap_wrlock     CONCAT2(SLOTMAP_FN_PREFIX, _wrlock)
+#define fn_slotmap_rdunlock   CONCAT2(SLOTMAP_FN_PREFIX, _rdunlock)
+#define fn_slotmap_wrunlock   CONCAT2(SLOTMAP_FN_PREFIX, _wrunlock)
+
+#define fn_slotmap_data       CONCAT2(SLOTMAP_FN_PREFIX, _data)
+#define fn_slotmap_size       CONCAT2(SLOTMAP_FN_PREFIX, _size)
+#define fn_slotmap_handle     CONCAT2(SLOTMAP_FN_PREFIX, _handle)
+#define fn_slotmap_valid      CONCAT2(SLOTMAP_FN_PREFIX, _valid)
+#define fn_slotmap_get        CONCAT2(SLOTMAP_FN_PREFIX, _get)
+
+#define fn_slotmap_insert     CONCAT2(SLOTMAP_FN_PREFIX, _insert)
+#define fn_slotmap_erase      CONCAT2(SLOTMAP_FN_PREFIX, _erase)
+#define fn_slotmap_clear      CONCAT2(SLOTMAP_FN_PREFIX, _clear)
+#define fn_slotmap_grow       CONCAT2(SLOTMAP_FN_PREFIX, _grow)
+#define fn_slotmap_compact    CONCAT2(SLOTMAP_FN_PREFIX, _compact)
+/** @endcond */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct struct_slotmap;
+typedef struct struct_slotmap struct_slotmap;
+typedef SLOTMAP_HANDLE_TYPE type_handle;
+
+struct_slotmap*     fn_slotmap_create     (struct_slotmap* map);
+void                fn_slotmap_destroy    (struct_slotmap* map);
+
+void                fn_slotmap_rdlock     (struct_slotmap* map);
+void                fn_slotmap_wrlock     (struct_slotmap* map);
+void                fn_slotmap_rdunlock   (struct_slotmap* map);
+void                fn_slotmap_wrunlock   (struct_slotmap* map);
+
+SLOTMAP_DATA_TYPE*  fn_slotmap_data       (struct_slotmap* map);
+size_t              fn_slotmap_size       (struct_slotmap* map);
+type_handle         fn_slotmap_handle     (struct_slotmap* map, size_t idx);
+int                 fn_slotmap_valid      (struct_slotmap* map, type_handle handle);
+SLOTMAP_DATA_TYPE*  fn_slotmap_get        (struct_slotmap* map, type_handle handle);
+
+type_handle         fn_slotmap_insert     (struct_slotmap* map, SLOTMAP_DATA_TYPE value);
+void                fn_slotmap_erase      (struct_slotmap* map, type_handle handle);
+void                fn_slotmap_clear      (struct_slotmap* map);
+void                fn_slotmap_compact    (struct_slotmap* map);
+
+/* Values live packed in data[0, size) and move when others are erased, so keep handles and never pointers.
+ * A slot generation is odd while it is in use, handle 0 is never valid and can be used as a null handle */
+#ifdef SLOTMAP_STRUCT
+  typedef struct struct_slot {
+    uint32_t            generation;
+    uint32_t            link;
+  } struct_slot;
+
+  struct struct_slotmap {
+    SLOTMAP_DATA_TYPE*  data;
+    uint32_t*           owners;
+    size_t              size;
+    size_t              capacity;
+    struct_slot*        slots;
+    size_t              slots_count;
+    size_t              slots_capacity;
+    uint32_t            free_head;
+    uint32_t            free_tail;
+    int                 allocated;
+    RWLOCK_TYPE         lock;
+  };
+#endif /* SLOTMAP_STRUCT */
+
+#ifdef SLOTMAP_IMPLEMENTATION
+
+struct_slotmap*     fn_slotmap_create(struct_slotmap* map) {
+  if (!map) {
+    CALLOC(map, struct struct_slotmap, 1);
+    map->allocated = true;
+  } else {
+    map->allocated = false;
+  }
+
+  map->size           = 0;
+  map->capacity       = SLOTMAP_INITIAL_SIZE;
+  map->slots_count    = 0;
+  map->slots_capacity = SLOTMAP_INITIAL_SIZE;
+  map->free_head      = SLOTMAP_NO_SLOT;
+  map->free_tail      = SLOTMAP_NO_SLOT;
+  CALLOC(map->data,   SLOTMAP_DATA_TYPE, map->capacity);
+  CALLOC(map->owners, uint32_t,          map->capacity);
+  CALLOC(map->slots,  struct_slot,       map->slots_capacity);
+  RWLOCK_INIT(map->lock);
+
+  return map;
+}
+void                fn_slotmap_destroy(struct_slotmap* map) {
+  BLOP_ASSERT_PTR(map);
+
+  BLOP_ASSERT(map->size == 0, "Destroying non empty slotmap (HINT: Clear the slotmap)");
+
+  RWLOCK_DESTROY(map->lock);
+  FREE(map->data);
+  FREE(map->owners);
+  FREE(map->slots);
+
+  if (map->allocated) {
+    FREE(map);
+  }
+}
+
+void                fn_slotmap_rdlock(struct_slotmap* map) {
+  BLOP_ASSERT_PTR(map);
+  RWLOCK_RDLOCK(map->lock);
+}
+void                fn_slotmap_wrlock(struct_slotmap* map) {
+  BLOP_ASSERT_PTR(map);
+  RWLOCK_WRLOCK(map->lock);
+}
+void                fn_slotmap_rdunlock(struct_slotmap* map) {
+  BLOP_ASSERT_PTR(map);
+  RWLOCK_RDUNLOCK(map->lock);
+}
+void                fn_slotmap_wrunlock(struct_slotmap* map) {
+  BLOP_ASSERT_PTR(map);
+  RWLOCK_WRUNLOCK(map->lock);
+}
+
+SLOTMAP_DATA_TYPE*  fn_slotmap_data(struct_slotmap* map) {
+  BLOP_ASSERT_PTR(map);
+  return map->data;
+}
+size_t              fn_slotmap_size(struct_slotmap* map) {
+  BLOP_ASSERT_PTR(map);
+  return map->size;
+}
+type_handle         fn_slotmap_handle(struct_slotmap* map, size_t idx) {
+  BLOP_ASSERT_PTR(map);
+
+  BLOP_ASSERT_BOUNDS(idx, map->size);
+  uint32_t slot = map->owners[idx];
+  return SLOTMAP_HANDLE(slot, map->slots[slot].generation);
+}
+int                 fn_slotmap_valid(struct_slotmap* map, type_handle handle) {
+  BLOP_ASSERT_PTR(map);
+
+  uint32_t slot       = SLOTMAP_HANDLE_INDEX(handle);
+  uint32_t generation = SLOTMAP_HANDLE_GENERATION(handle);
+  return slot < map->slots_count && (generation & 1) && map->slots[slot].generation == generation;
+}
+SLOTMAP_DATA_TYPE*  fn_slotmap_get(struct_slotmap* map, type_handle handle) {
+  BLOP_ASSERT_PTR(map);
+
+  if (!fn_slotmap_valid(map, handle)) {
+    return NULL;
+  }
+  return &map->data[map->slots[SLOTMAP_HANDLE_INDEX(handle)].link];
+}
+
+static void         fn_slotmap_grow(struct_slotmap* map) {
+  if (map->size == map->capacity) {
+    size_t capacity = map->capacity * 2;
+    REALLOC(map->data,   SLOTMAP_DATA_TYPE, map->data,   capacity * sizeof(SLOTMAP_DATA_TYPE));
+    REALLOC(map->owners, uint32_t,          map->owners, capacity * sizeof(uint32_t));
+    map->capacity = capacity;
+  }
+
+  if (map->slots_count == map->slots_capacity) {
+    size_t capacity = MIN(map->slots_capacity * 2, SLOTMAP_SLOTS_MAX);
+    BLOP_ASSERT_FORCED(capacity > map->slots_count, "Slotmap ran out of handle indices (HINT: Raise SLOTMAP_INDEX_BITS)");
+    REALLOC(map->slots, struct_slot, map->slots, capacity * sizeof(struct_slot));
+    map->slots_capacity = capacity;
+  }
+}
+
+type_handle         fn_slotmap_insert(struct_slotmap* map, SLOTMAP_DATA_TYPE value) {
+  BLOP_ASSERT_PTR(map);
+
+  /* Free slots are reused first in first out so generations wear evenly before they wrap around */
+  uint32_t slot = map->free_head;
+  if (slot != SLOTMAP_NO_SLOT) {
+    map->free_head = map->slots[slot].link;
+    if (map->free_head == SLOTMAP_NO_SLOT) {
+      map->free_tail = SLOTMAP_NO_SLOT;
+    }
+    if (map->size == map->capacity) {
+      fn_slotmap_grow(map);
+    }
+  } else {
+    fn_slotmap_grow(map);
+    slot = (uint32_t)map->slots_count++;
+    map->slots[slot].generation = 0;
+  }
+
+  struct_slot* entry = &map->slots[slot];
+  entry->generation  = (entry->generation + 1) & SLOTMAP_GENERATION_MASK;
+  entry->link        = (uint32_t)map->size;
+
+  map->data[map->size]   = value;
+  map->owners[map->size] = slot;
+  map->size++;
+
+  return SLOTMAP_HANDLE(slot, entry->generation);
+}
+void                fn_slotmap_erase(struct_slotmap* map, type_handle handle) {
+  BLOP_ASSERT_PTR(map);
+
+  BLOP_ASSERT_FORCED(fn_slotmap_valid(map, handle), "Erasing a stale or invalid slotmap handle");
+
+  uint32_t     slot  = SLOTMAP_HANDLE_INDEX(handle);
+  struct_slot* entry = &map->slots[slot];
+  uint32_t     idx   = entry->link;
+
+  #ifdef SLOTMAP_DEALLOCATE_DATA
+    SLOTMAP_DEALLOCATE_DATA(map->data[idx]);
+  #endif /* SLOTMAP_DEALLOCATE_DATA */
+
+  /* The last value fills the hole so data stays packed */
+  uint32_t last = (uint32_t)map->size - 1;
+  if (idx != last) {
+    map->data[idx]   = map->data[last];
+    map->owners[idx] = map->owners[last];
+    map->slots[map->owners[idx]].link = idx;
+  }
+  map->size--;
+
+  entry->generation = (entry->generation + 1) & SLOTMAP_GENERATION_MASK;
+  entry->link       = SLOTMAP_NO_SLOT;
+  if (map->free_tail != SLOTMAP_NO_SLOT) {
+    map->slots[map->free_tail].link = slot;
+  } else {
+    map->free_head = slot;
+  }
+  map->free_tail = slot;
+}
+void                fn_slotmap_clear(struct_slotmap* map) {
+  BLOP_ASSERT_PTR(map);
+
+  while (map->size) {
+    uint32_t slot = map->owners[map->size - 1];
+    fn_slotmap_erase(map, SLOTMAP_HANDLE(slot, map->slots[slot].generation));
+  }
+}
+void                fn_slotmap_compact(struct_slotmap* map) {
+  BLOP_ASSERT_PTR(map);
+
+  /* Only the packed values are shrunk, slots keep their generations so stale handles stay detectable */
+  size_t capacity = MAX(map->size, (size_t)SLOTMAP_INITIAL_SIZE);
+  if (capacity < map->capacity) {
+    REALLOC(map->data,   SLOTMAP_DATA_TYPE, map->data,   capacity * sizeof(SLOTMAP_DATA_TYPE));
+    REALLOC(map->owners, uint32_t,          map->owners, capacity * sizeof(uint32_t));
+    map->capacity = capacity;
+  }
+}
+
+#endif /* SLOTMAP_IMPLEMENTATION */
+
+#ifdef __cplusplus
+}
+#endif
+
+#undef SLOTMAP_NAME
+#undef SLOTMAP_FN_PREFIX
+
+#undef SLOTMAP_DATA_TYPE
+#undef SLOTMAP_INITIAL_SIZE
+#undef SLOTMAP_DEALLOCATE_DATA
+
+#undef SLOTMAP_HANDLE_64
+#undef SLOTMAP_HANDLE_TYPE
+#undef SLOTMAP_HANDLE_BITS
+#undef SLOTMAP_INDEX_BITS
+#undef SLOTMAP_GENERATION_BITS
+#undef SLOTMAP_INDEX_MASK
+#undef SLOTMAP_GENERATION_MASK
+#undef SLOTMAP_SLOTS_MAX
+#undef SLOTMAP_NO_SLOT
+
+#undef SLOTMAP_HANDLE
+#undef SLOTMAP_HANDLE_INDEX
+#undef SLOTMAP_HANDLE_GENERATION
+
+#undef SLOTMAP_STRUCT
+#undef SLOTMAP_IMPLEMENTATION
+
+#undef struct_slotmap
+#undef struct_slot
+#undef type_handle
+
+#undef fn_slotmap_create
+#undef fn_slotmap_destroy
+
+#undef fn_slotmap_rdlock
+#undef fn_slotmap_wrlock
+#undef fn_slotmap_rdunlock
+#undef fn_slotmap_wrunlock
+
+#undef fn_slotmap_data
+#undef fn_slotmap_size
+#undef fn_slotmap_handle
+#undef fn_slotmap_valid
+#undef fn_slotmap_get
+
+#undef fn_slotmap_insert
+#undef fn_slotmap_erase
+#undef fn_slotmap_clear
+#undef fn_slotmap_grow
+#undef fn_slotmap_compact
@@ -20,10 +20,66 @@
   #define VECTOR_SHRINK_POLICIE(capacity) (capacity / 4)
 #endif /* VECTOR_SHRINK_POLICIE */
 
+/* Capacity left after an automatic shrink, kept well above VECTOR_SHRINK_POLICIE so push/pop around the threshold does not reallocate every time */
+#ifndef VECTOR_SHRINK_TARGET
+  #define VECTOR_SHRINK_TARGET(capacity) (capacity / 2)
+#endif /* VECTOR_SHRINK_TARGET */
+
 #if !defined(VECTOR_INITIAL_SIZE) || VECTOR_INITIAL_SIZE <= 0
   #define VECTOR_INITIAL_SIZE 10
 #endif /* VECTOR_INITIAL_SIZE */
 
+/* Up to VECTOR_INLINE_CAPACITY elements are stored inside the vector struct itself, which then must not be moved or copied */
+#if defined(VECTOR_INLINE_CAPACITY) && VECTOR_INLINE_CAPACITY <= 0
+  #error "VECTOR_INLINE_CAPACITY must be greater than zero"
+#endif /* VECTOR_INLINE_CAPACITY */
+
+/* VECTOR_NUMERIC adds find/count/min/max/sum/dot/fill for arithmetic types, VECTOR_SIMD (i32 or f32) routes them to the kernels of blop/simd.h */
+#ifdef VECTOR_SIMD
+  #include <blop/simd.h>
+  #define VECTOR_NUMERIC
+  #define VECTOR_SIMD_TYPE     CONCAT3(blop_simd_, VECTOR_SIMD, _type)
+  #define VECTOR_SIMD_FN(name) CONCAT3(blop_simd_, VECTOR_SIMD, CONCAT2(_, name))
+#endif /* VECTOR_SIMD */
+
+#if defined(VECTOR_NUMERIC) && !defined(VECTOR_SUM_TYPE)
+  #ifdef VECTOR_SIMD
+    #define VECTOR_SUM_TYPE CONCAT3(blop_simd_, VECTOR_SIMD, _wide)
+  #else
+    #define VECTOR_SUM_TYPE VECTOR_DATA_TYPE
+  #endif /* VECTOR_SIMD */
+#endif /* VECTOR_SUM_TYPE */
+
+/* VECTOR_COMPARE(a, b) (a strict weak order, true when a sorts before b) enables sort, VECTOR_RADIX_KEY(x) (an unsigned VECTOR_RADIX_KEY_TYPE) enables radix_sort */
+#if defined(VECTOR_NUMERIC) && !defined(VECTOR_COMPARE)
+  #define VECTOR_COMPARE(a, b) ((a) < (b))
+#endif /* VECTOR_COMPARE */
+
+/* Block partitioning, comparisons only feed offsets so they never mispredict. Pays off for cheap comparisons and small elements */
+#if defined(VECTOR_NUMERIC) && !defined(VECTOR_SORT_BRANCHLESS)
+  #define VECTOR_SORT_BRANCHLESS
+#endif /* VECTOR_SORT_BRANCHLESS */
+
+#if defined(VECTOR_SIMD) && !defined(VECTOR_RADIX_KEY)
+  #define VECTOR_RADIX_KEY(x) CONCAT2(blop_radix_, VECTOR_SIMD)(x)
+#endif /* VECTOR_RADIX_KEY */
+
+#if defined(VECTOR_RADIX_KEY) && !defined(VECTOR_RADIX_KEY_TYPE)
+  #define VECTOR_RADIX_KEY_TYPE uint32_t
+#endif /* VECTOR_RADIX_KEY_TYPE */
+
+/* Global switch, DISABLE_VECTOR_CHECKS drops the ptr and bounds checks of get/set/front/back in every vector */
+#ifndef DISABLE_VECTOR_CHECKS
+  #define VECTOR_CHECK(vec, idx, bound) do { BLOP_ASSERT_PTR(vec); BLOP_ASSERT_BOUNDS(idx, bound); } while(0)
+#else
+  #define VECTOR_CHECK(vec, idx, bound) ((void)0)
+#endif /* DISABLE_VECTOR_CHECKS */
+
+/* Walks data[0, size) with a plain pointer, the vector must not grow or shrink inside the loop. Shared by every vector, never undefined */
+#ifndef VECTOR_FOREACH
+  #define VECTOR_FOREACH(type, it, vec) for (type* it = (vec)->data, *it##_end = (vec)->data + (vec)->size; it != it##_end; it++)
+#endif /* VECTOR_FOREACH */
+
 /** @cond doxygen_ignore */
 #define struct_vector         VECTOR_NAME
 
@@ -42,8 +98,15 @@
 
 #define fn_vector_set         CONCAT2(VECTOR_FN_PREFIX, _set)
 #define fn_vector_get         CONCAT2(VECTOR_FN_PREFIX, _get)
+#define fn_vector_at          CONCAT2(VECTOR_FN_PREFIX, _at)
+#define fn_vector_set_unchecked CONCAT2(VECTOR_FN_PREFIX, _set_unchecked)
+#define fn_vector_get_unchecked CONCAT2(VECTOR_FN_PREFIX, _get_unchecked)
 #define fn_vector_resize      CONCAT2(VECTOR_FN_PREFIX, _resize)
+#define fn_vector_reserve     CONCAT2(VECTOR_FN_PREFIX, _reserve)
+#define fn_vector_resize_uninit CONCAT2(VECTOR_FN_PREFIX, _resize_uninit)
 #define fn_vector_shrink      CONCAT2(VECTOR_FN_PREFIX, _shrink)
+#define fn_vector_shrink_to_fit CONCAT2(VECTOR_FN_PREFIX, _shrink_to_fit)
+#define fn_vector_grow        CONCAT2(VECTOR_FN_PREFIX, _grow)
 
 #define fn_vector_clear       CONCAT2(VECTOR_FN_PREFIX, _clear)
 #define fn_vector_erase       CONCAT2(VECTOR_FN_PREFIX, _erase)
@@ -54,8 +117,33 @@
 #define fn_vector_push_back   CONCAT2(VECTOR_FN_PREFIX, _push_back)
 #define fn_vector_push_front  CONCAT2(VECTOR_FN_PREFIX, _push_front)
 
+#define fn_vector_append      CONCAT2(VECTOR_FN_PREFIX, _append)
+#define fn_vector_insert_range CONCAT2(VECTOR_FN_PREFIX, _insert_range)
+#define fn_vector_extend_from CONCAT2(VECTOR_FN_PREFIX, _extend_from)
+
 #define fn_vector_memcpy      CONCAT2(VECTOR_FN_PREFIX, _memcpy)
 #define fn_vector_memset      CONCAT2(VECTOR_FN_PREFIX, _memset)
+
+#define fn_vector_find        CONCAT2(VECTOR_FN_PREFIX, _find)
+#define fn_vector_count       CONCAT2(VECTOR_FN_PREFIX, _count)
+#define fn_vector_min         CONCAT2(VECTOR_FN_PREFIX, _min)
+#define fn_vector_max         CONCAT2(VECTOR_FN_PREFIX, _max)
+#define fn_vector_sum         CONCAT2(VECTOR_FN_PREFIX, _sum)
+#define fn_vector_dot         CONCAT2(VECTOR_FN_PREFIX, _dot)
+#define fn_vector_fill        CONCAT2(VECTOR_FN_PREFIX, _fill)
+
+#define fn_vector_sort        CONCAT2(VECTOR_FN_PREFIX, _sort)
+#define fn_vector_sort_loop   CONCAT2(VECTOR_FN_PREFIX, _sort_loop)
+#define fn_vector_sort_insertion CONCAT2(VECTOR_FN_PREFIX, _sort_insertion)
+#define fn_vector_sort_unguarded CONCAT2(VECTOR_FN_PREFIX, _sort_unguarded)
+#define fn_vector_sort_partial   CONCAT2(VECTOR_FN_PREFIX, _sort_partial)
+#define fn_vector_sort_heap   CONCAT2(VECTOR_FN_PREFIX, _sort_heap)
+#define fn_vector_sort_sift   CONCAT2(VECTOR_FN_PREFIX, _sort_sift)
+#define fn_vector_sort3       CONCAT2(VECTOR_FN_PREFIX, _sort3)
+#define fn_vector_partition_left  CONCAT2(VECTOR_FN_PREFIX, _partition_left)
+#define fn_vector_partition_right CONCAT2(VECTOR_FN_PREFIX, _partition_right)
+#define fn_vector_swap_offsets    CONCAT2(VECTOR_FN_PREFIX, _swap_offsets)
+#define fn_vector_radix_sort  CONCAT2(VECTOR_FN_PREFIX, _radix_sort)
 /** @endcond */
 
 #ifdef __cplusplus
@@ -81,7 +169,10 @@ VECTOR_DATA_TYPE  fn_vector_front     (struct_vector* vec);
 void              fn_vector_set       (struct_vector* vec, size_t idx,        VECTOR_DATA_TYPE value);
 VECTOR_DATA_TYPE  fn_vector_get       (struct_vector* vec, size_t idx);
 void              fn_vector_resize    (struct_vector* vec, size_t size);
+void              fn_vector_reserve   (struct_vector* vec, size_t capacity);
+void              fn_vector_resize_uninit(struct_vector* vec, size_t size);
 void              fn_vector_shrink    (struct_vector* vec);
+void              fn_vector_shrink_to_fit(struct_vector* vec);
 
 void              fn_vector_clear     (struct_vector* vec);
 void              fn_vector_erase     (struct_vector* vec, size_t idx);
@@ -92,9 +183,30 @@ void              fn_vector_insert    (struct_vector* vec, size_t idx,        VE
 void              fn_vector_push_back (struct_vector* vec,                    VECTOR_DATA_TYPE value);
 void              fn_vector_push_front(struct_vector* vec,                    VECTOR_DATA_TYPE value);
 
+void              fn_vector_append    (struct_vector* vec,             const  VECTOR_DATA_TYPE* src,  size_t count);
+void              fn_vector_insert_range(struct_vector* vec, size_t idx, const VECTOR_DATA_TYPE* src, size_t count);
+void              fn_vector_extend_from(struct_vector* vec, struct_vector* other);
+
 void              fn_vector_memcpy    (struct_vector* vec, size_t idx, const  VECTOR_DATA_TYPE* src,  size_t count);
 void              fn_vector_memset    (struct_vector* vec, size_t idx,        VECTOR_DATA_TYPE value, size_t count);
 
+#ifdef VECTOR_NUMERIC
+  size_t            fn_vector_find      (struct_vector* vec, VECTOR_DATA_TYPE value);
+  size_t            fn_vector_count     (struct_vector* vec, VECTOR_DATA_TYPE value);
+  VECTOR_DATA_TYPE  fn_vector_min       (struct_vector* vec);
+  VECTOR_DATA_TYPE  fn_vector_max       (struct_vector* vec);
+  VECTOR_SUM_TYPE   fn_vector_sum       (struct_vector* vec);
+  VECTOR_SUM_TYPE   fn_vector_dot       (struct_vector* vec, struct_vector* other);
+  void              fn_vector_fill      (struct_vector* vec, VECTOR_DATA_TYPE value);
+#endif /* VECTOR_NUMERIC */
+
+#ifdef VECTOR_COMPARE
+  void              fn_vector_sort      (struct_vector* vec);
+#endif /* VECTOR_COMPARE */
+#ifdef VECTOR_RADIX_KEY
+  void              fn_vector_radix_sort(struct_vector* vec);
+#endif /* VECTOR_RADIX_KEY */
+
 #ifdef VECTOR_STRUCT
   struct struct_vector {
     VECTOR_DATA_TYPE* data;
@@ -102,11 +214,54 @@ void              fn_vector_memset    (struct_vector* vec, size_t idx,        VE
     size_t            capacity;
     int               allocated;
     RWLOCK_TYPE  lock;
+
+    #ifdef VECTOR_INLINE_CAPACITY
+      VECTOR_DATA_TYPE  inline_data[VECTOR_INLINE_CAPACITY];
+    #endif /* VECTOR_INLINE_CAPACITY */
   };
+
+  /* Unchecked accessors, inlined in every translation unit so hot loops become plain pointer arithmetic */
+  static inline VECTOR_DATA_TYPE* fn_vector_at(struct_vector* vec, size_t idx) {
+    return &vec->data[idx];
+  }
+  static inline void              fn_vector_set_unchecked(struct_vector* vec, size_t idx, VECTOR_DATA_TYPE value) {
+    vec->data[idx] = value;
+  }
+  static inline VECTOR_DATA_TYPE  fn_vector_get_unchecked(struct_vector* vec, size_t idx) {
+    return vec->data[idx];
+  }
 #endif /* VECTOR_STRUCT */
 
 #ifdef VECTOR_IMPLEMENTATION
 
+static void       fn_vector_grow(struct_vector* vec, size_t capacity) {
+  /* Capacities that fit inline go back to the inline storage, the first one past it spills to the heap */
+  #ifdef VECTOR_INLINE_CAPACITY
+    if (capacity <= VECTOR_INLINE_CAPACITY) {
+      if (vec->data != vec->inline_data) {
+        memcpy(vec->inline_data, vec->data, vec->size * sizeof(VECTOR_DATA_TYPE));
+        FREE(vec->data);
+        vec->data = vec->inline_data;
+      }
+      vec->capacity = VECTOR_INLINE_CAPACITY;
+      return;
+    }
+
+    if (vec->data == vec->inline_data) {
+      VECTOR_DATA_TYPE* data = (VECTOR_DATA_TYPE*)MEM_MALLOC(capacity * sizeof(VECTOR_DATA_TYPE));
+      ASSERT_MALLOC(data, VECTOR_DATA_TYPE, capacity * sizeof(VECTOR_DATA_TYPE));
+      memcpy(data, vec->inline_data, vec->size * sizeof(VECTOR_DATA_TYPE));
+      vec->data     = data;
+      vec->capacity = capacity;
+      return;
+    }
+  #endif /* VECTOR_INLINE_CAPACITY */
+
+  /* realloc lets the allocator extend (or shrink) the buffer in place instead of always copying it */
+  REALLOC(vec->data, VECTOR_DATA_TYPE, vec->data, capacity * sizeof(VECTOR_DATA_TYPE));
+  vec->capacity = capacity;
+}
+
 struct_vector*    fn_vector_create(struct_vector* vec) {
   if (!vec) {
     CALLOC(vec, struct struct_vector, 1);
@@ -116,8 +271,13 @@ struct_vector*    fn_vector_create(struct_vector* vec) {
   }
 
   vec->size = 0;
-  vec->capacity = VECTOR_INITIAL_SIZE;
-  CALLOC(vec->data, VECTOR_DATA_TYPE, vec->capacity);
+  #ifdef VECTOR_INLINE_CAPACITY
+    vec->data     = vec->inline_data;
+    vec->capacity = VECTOR_INLINE_CAPACITY;
+  #else
+    vec->data = NULL;
+    fn_vector_grow(vec, VECTOR_INITIAL_SIZE);
+  #endif /* VECTOR_INLINE_CAPACITY */
   RWLOCK_INIT(vec->lock);
 
   return vec;
@@ -128,7 +288,13 @@ void              fn_vector_destroy(struct_vector* vec) {
   BLOP_ASSERT(vec->size == 0, "Destroying non empty vector (HINT: Clear the vector)");
 
   RWLOCK_DESTROY(vec->lock);
-  FREE(vec->data);
+  #ifdef VECTOR_INLINE_CAPACITY
+    if (vec->data != vec->inline_data) {
+      FREE(vec->data);
+    }
+  #else
+    FREE(vec->data);
+  #endif /* VECTOR_INLINE_CAPACITY */
 
   if (vec->allocated) {
     FREE(vec);
@@ -161,28 +327,28 @@ size_t            fn_vector_size(struct_vector* vec) {
   return vec->size;
 }
 VECTOR_DATA_TYPE  fn_vector_back(struct_vector* vec) {
-  BLOP_ASSERT_PTR(vec);
-  
-  BLOP_ASSERT_FORCED(vec->size != 0, "Vector has no back (size == 0)");
+  #ifndef DISABLE_VECTOR_CHECKS
+    BLOP_ASSERT_PTR(vec);
+    BLOP_ASSERT_FORCED(vec->size != 0, "Vector has no back (size == 0)");
+  #endif /* DISABLE_VECTOR_CHECKS */
+
   return vec->data[vec->size - 1];
 }
 VECTOR_DATA_TYPE  fn_vector_front(struct_vector* vec) {
-  BLOP_ASSERT_PTR(vec);
-  
-  BLOP_ASSERT_FORCED(vec->size != 0, "Vector has no front (size == 0)");
+  #ifndef DISABLE_VECTOR_CHECKS
+    BLOP_ASSERT_PTR(vec);
+    BLOP_ASSERT_FORCED(vec->size != 0, "Vector has no front (size == 0)");
+  #endif /* DISABLE_VECTOR_CHECKS */
+
   return vec->data[0];
 }
 
 void              fn_vector_set(struct_vector* vec, size_t idx, VECTOR_DATA_TYPE value) {
-  BLOP_ASSERT_PTR(vec);
-
-  BLOP_ASSERT_BOUNDS(idx, vec->size);
+  VECTOR_CHECK(vec, idx, vec->size);
   vec->data[idx] = value;
 }
 VECTOR_DATA_TYPE  fn_vector_get(struct_vector* vec, size_t idx) {
-  BLOP_ASSERT_PTR(vec);
-
-  BLOP_ASSERT_BOUNDS(idx, vec->size);
+  VECTOR_CHECK(vec, idx, vec->size);
   return vec->data[idx];
 }
 void              fn_vector_resize(struct_vector* vec, size_t size) {
@@ -203,33 +369,59 @@ void              fn_vector_resize(struct_vector* vec, size_t size) {
         VECTOR_DEALLOCATE_DATA(vec->data[i]);
       }
     #endif /* VECTOR_DEALLOCATE_DATA */
+
+    vec->size = size;
+    return;
+  }
+
+  /* Sizes within capacity never allocate, new elements are zeroed as if they came from calloc */
+  if (size > vec->capacity) {
+    fn_vector_grow(vec, VECTOR_RESIZE_POLICIE(size));
   }
+  memset(&vec->data[vec->size], 0, (size - vec->size) * sizeof(VECTOR_DATA_TYPE));
+  vec->size = size;
+}
+void              fn_vector_reserve(struct_vector* vec, size_t capacity) {
+  BLOP_ASSERT_PTR(vec);
 
-  vec->capacity = TERNARY(
-    size < VECTOR_INITIAL_SIZE,
-    VECTOR_INITIAL_SIZE,
-    VECTOR_RESIZE_POLICIE(size)
-  );
+  if (capacity > vec->capacity) {
+    fn_vector_grow(vec, capacity);
+  }
+}
+void              fn_vector_resize_uninit(struct_vector* vec, size_t size) {
+  BLOP_ASSERT_PTR(vec);
 
-  VECTOR_DATA_TYPE* data = NULL;
-  CALLOC(data, VECTOR_DATA_TYPE, vec->capacity);
-  memcpy(data, vec->data, MIN(vec->size, size) * sizeof(VECTOR_DATA_TYPE));
+  /* Like resize but new elements are left uninitialized, meant for callers that overwrite them right away.
+   * It grows to exactly size, like reserve, since bulk loads know their final size */
+  if (size < vec->size) {
+    #ifdef VECTOR_DEALLOCATE_DATA
+      for (size_t i = size; i < vec->size; i++) {
+        VECTOR_DEALLOCATE_DATA(vec->data[i]);
+      }
+    #endif /* VECTOR_DEALLOCATE_DATA */
+  } else if (size > vec->capacity) {
+    fn_vector_grow(vec, size);
+  }
 
-  FREE(vec->data);
-  vec->data = data;
   vec->size = size;
 }
 void              fn_vector_shrink(struct_vector* vec) {
   BLOP_ASSERT_PTR(vec);
 
-  if (vec->size < VECTOR_SHRINK_POLICIE(vec->capacity) && vec->size < VECTOR_INITIAL_SIZE) {
-    vec->capacity = VECTOR_RESIZE_POLICIE(vec->size);
-    VECTOR_DATA_TYPE* data = NULL;
-    CALLOC(data, VECTOR_DATA_TYPE, vec->capacity);
+  /* Only below a quarter of the capacity, and then only down to half of it, never under VECTOR_INITIAL_SIZE */
+  if (vec->size < VECTOR_SHRINK_POLICIE(vec->capacity)) {
+    size_t capacity = MAX((size_t)VECTOR_SHRINK_TARGET(vec->capacity), (size_t)VECTOR_INITIAL_SIZE);
+    if (capacity < vec->capacity) {
+      fn_vector_grow(vec, capacity);
+    }
+  }
+}
+void              fn_vector_shrink_to_fit(struct_vector* vec) {
+  BLOP_ASSERT_PTR(vec);
 
-    memcpy(data, vec->data, vec->size * sizeof(VECTOR_DATA_TYPE));
-    FREE(vec->data);
-    vec->data = data;
+  size_t capacity = MAX(vec->size, (size_t)1);
+  if (capacity < vec->capacity) {
+    fn_vector_grow(vec, capacity);
   }
 }
 
@@ -243,9 +435,15 @@ void              fn_vector_clear(struct_vector* vec) {
   #endif /* VECTOR_DEALLOCATE_DATA */
 
   vec->size = 0;
-  vec->capacity = VECTOR_INITIAL_SIZE;
-  FREE(vec->data);
-  CALLOC(vec->data, VECTOR_DATA_TYPE, vec->capacity);
+
+  /* The storage is kept for the next fill, VECTOR_CLEAR_RELEASE gives it back down to VECTOR_INITIAL_SIZE (or the inline storage) */
+  #if defined(VECTOR_CLEAR_RELEASE) && defined(VECTOR_INLINE_CAPACITY)
+    fn_vector_grow(vec, 0);
+  #elif defined(VECTOR_CLEAR_RELEASE)
+    if (vec->capacity > VECTOR_INITIAL_SIZE) {
+      fn_vector_grow(vec, VECTOR_INITIAL_SIZE);
+    }
+  #endif /* VECTOR_CLEAR_RELEASE */
 }
 void              fn_vector_erase(struct_vector* vec, size_t idx) {
   BLOP_ASSERT_PTR(vec);
@@ -262,7 +460,10 @@ void              fn_vector_erase(struct_vector* vec, size_t idx) {
   
   vec->size--;
 
-  fn_vector_shrink(vec);
+  /* VECTOR_NO_AUTO_SHRINK leaves reclaiming memory to explicit fn_vector_shrink/fn_vector_shrink_to_fit calls */
+  #ifndef VECTOR_NO_AUTO_SHRINK
+    fn_vector_shrink(vec);
+  #endif /* VECTOR_NO_AUTO_SHRINK */
 }
 void              fn_vector_pop_back(struct_vector* vec) {
   BLOP_ASSERT_PTR(vec);
@@ -290,25 +491,12 @@ void              fn_vector_insert(struct_vector* vec, size_t idx, VECTOR_DATA_T
 
   BLOP_ASSERT_BOUNDS(idx, vec->size + 1);
 
-  if (vec->size != vec->capacity) {
-    if (idx != vec->size) {
-      memmove(&vec->data[idx + 1], &vec->data[idx], (vec->size - idx) * sizeof(VECTOR_DATA_TYPE));
-    }
-  } else {
-    vec->capacity = VECTOR_RESIZE_POLICIE(vec->size);
-    VECTOR_DATA_TYPE* data = NULL;
-    CALLOC(data, VECTOR_DATA_TYPE, vec->capacity);
-
-    if (idx != 0) {
-      memcpy(data, vec->data, idx * sizeof(VECTOR_DATA_TYPE));
-    }
-    
-    if (idx != vec->size) {
-      memcpy(&data[idx + 1], &vec->data[idx], (vec->size - idx) * sizeof(VECTOR_DATA_TYPE));
-    }
+  if (vec->size == vec->capacity) {
+    fn_vector_grow(vec, VECTOR_RESIZE_POLICIE(vec->size));
+  }
 
-    FREE(vec->data);
-    vec->data = data;
+  if (idx != vec->size) {
+    memmove(&vec->data[idx + 1], &vec->data[idx], (vec->size - idx) * sizeof(VECTOR_DATA_TYPE));
   }
 
   vec->data[idx] = value;
@@ -325,6 +513,43 @@ void              fn_vector_push_front(struct_vector* vec, VECTOR_DATA_TYPE valu
   fn_vector_insert(vec, 0, value);
 }
 
+void              fn_vector_append(struct_vector* vec, const VECTOR_DATA_TYPE* src, size_t count) {
+  BLOP_ASSERT_PTR(vec);
+
+  fn_vector_insert_range(vec, vec->size, src, count);
+}
+void              fn_vector_insert_range(struct_vector* vec, size_t idx, const VECTOR_DATA_TYPE* src, size_t count) {
+  BLOP_ASSERT_PTR(vec);
+  BLOP_ASSERT_BOUNDS(idx, vec->size + 1);
+
+  if (count == 0) { return; }
+  BLOP_ASSERT_PTR(src);
+
+  /* src must not point into the vector, growing may move the buffer it points to */
+  if (vec->size + count > vec->capacity) {
+    fn_vector_grow(vec, VECTOR_RESIZE_POLICIE(vec->size + count));
+  }
+
+  if (idx != vec->size) {
+    memmove(&vec->data[idx + count], &vec->data[idx], (vec->size - idx) * sizeof(VECTOR_DATA_TYPE));
+  }
+  memcpy(&vec->data[idx], src, count * sizeof(VECTOR_DATA_TYPE));
+  vec->size += count;
+}
+void              fn_vector_extend_from(struct_vector* vec, struct_vector* other) {
+  BLOP_ASSERT_PTR(vec);
+  BLOP_ASSERT_PTR(other);
+
+  /* Grown before reading other->data so a vector can be extended from itself */
+  size_t count = other->size;
+  if (vec->size + count > vec->capacity) {
+    fn_vector_grow(vec, VECTOR_RESIZE_POLICIE(vec->size + count));
+  }
+
+  memcpy(&vec->data[vec->size], other->data, count * sizeof(VECTOR_DATA_TYPE));
+  vec->size += count;
+}
+
 void              fn_vector_memcpy(struct_vector* vec, size_t idx, const VECTOR_DATA_TYPE* src, size_t count) {
   BLOP_ASSERT_PTR(vec);
   BLOP_ASSERT_PTR(src);
@@ -344,11 +569,497 @@ void              fn_vector_memset(struct_vector* vec, size_t idx, VECTOR_DATA_T
   BLOP_ASSERT_BOUNDS(idx, vec->size);
   BLOP_ASSERT_BOUNDS(idx + count, vec->size + 1);
 
+  #ifdef VECTOR_SIMD
+    VECTOR_SIMD_FN(fill)((VECTOR_SIMD_TYPE*)&vec->data[idx], count, value);
+  #else
+    for (size_t i = 0; i < count; i++) {
+      vec->data[idx + i] = value;
+    }
+  #endif /* VECTOR_SIMD */
+}
+
+#ifdef VECTOR_NUMERIC
+
+#ifdef VECTOR_SIMD
+  STATIC_ASSERT(sizeof(VECTOR_DATA_TYPE) == sizeof(VECTOR_SIMD_TYPE), "VECTOR_DATA_TYPE does not match the VECTOR_SIMD kernels");
+#endif /* VECTOR_SIMD */
+
+/* Returns vec->size when no element is equal to value */
+size_t            fn_vector_find(struct_vector* vec, VECTOR_DATA_TYPE value) {
+  BLOP_ASSERT_PTR(vec);
+
+  #ifdef VECTOR_SIMD
+    return VECTOR_SIMD_FN(find)((const VECTOR_SIMD_TYPE*)vec->data, vec->size, value);
+  #else
+    for (size_t i = 0; i < vec->size; i++) {
+      if (vec->data[i] == value) {
+        return i;
+      }
+    }
+    return vec->size;
+  #endif /* VECTOR_SIMD */
+}
+size_t            fn_vector_count(struct_vector* vec, VECTOR_DATA_TYPE value) {
+  BLOP_ASSERT_PTR(vec);
+
+  #ifdef VECTOR_SIMD
+    return VECTOR_SIMD_FN(count)((const VECTOR_SIMD_TYPE*)vec->data, vec->size, value);
+  #else
+    size_t count = 0;
+    for (size_t i = 0; i < vec->size; i++) {
+      count += vec->data[i] == value;
+    }
+    return count;
+  #endif /* VECTOR_SIMD */
+}
+VECTOR_DATA_TYPE  fn_vector_min(struct_vector* vec) {
+  BLOP_ASSERT_PTR(vec);
+
+  BLOP_ASSERT_FORCED(vec->size != 0, "Vector has no min (size == 0)");
+  #ifdef VECTOR_SIMD
+    return VECTOR_SIMD_FN(min)((const VECTOR_SIMD_TYPE*)vec->data, vec->size);
+  #else
+    VECTOR_DATA_TYPE result = vec->data[0];
+    for (size_t i = 1; i < vec->size; i++) {
+      result = MIN(result, vec->data[i]);
+    }
+    return result;
+  #endif /* VECTOR_SIMD */
+}
+VECTOR_DATA_TYPE  fn_vector_max(struct_vector* vec) {
+  BLOP_ASSERT_PTR(vec);
+
+  BLOP_ASSERT_FORCED(vec->size != 0, "Vector has no max (size == 0)");
+  #ifdef VECTOR_SIMD
+    return VECTOR_SIMD_FN(max)((const VECTOR_SIMD_TYPE*)vec->data, vec->size);
+  #else
+    VECTOR_DATA_TYPE result = vec->data[0];
+    for (size_t i = 1; i < vec->size; i++) {
+      result = MAX(result, vec->data[i]);
+    }
+    return result;
+  #endif /* VECTOR_SIMD */
+}
+VECTOR_SUM_TYPE   fn_vector_sum(struct_vector* vec) {
+  BLOP_ASSERT_PTR(vec);
+
+  #ifdef VECTOR_SIMD
+    return VECTOR_SIMD_FN(sum)((const VECTOR_SIMD_TYPE*)vec->data, vec->size);
+  #else
+    VECTOR_SUM_TYPE sum = 0;
+    for (size_t i = 0; i < vec->size; i++) {
+      sum += vec->data[i];
+    }
+    return sum;
+  #endif /* VECTOR_SIMD */
+}
+VECTOR_SUM_TYPE   fn_vector_dot(struct_vector* vec, struct_vector* other) {
+  BLOP_ASSERT_PTR(vec);
+  BLOP_ASSERT_PTR(other);
+
+  BLOP_ASSERT_FORCED(vec->size == other->size, "Dot product of vectors with different sizes");
+  #ifdef VECTOR_SIMD
+    return VECTOR_SIMD_FN(dot)((const VECTOR_SIMD_TYPE*)vec->data, (const VECTOR_SIMD_TYPE*)other->data, vec->size);
+  #else
+    VECTOR_SUM_TYPE dot = 0;
+    for (size_t i = 0; i < vec->size; i++) {
+      dot += (VECTOR_SUM_TYPE)vec->data[i] * other->data[i];
+    }
+    return dot;
+  #endif /* VECTOR_SIMD */
+}
+void              fn_vector_fill(struct_vector* vec, VECTOR_DATA_TYPE value) {
+  BLOP_ASSERT_PTR(vec);
+
+  #ifdef VECTOR_SIMD
+    VECTOR_SIMD_FN(fill)((VECTOR_SIMD_TYPE*)vec->data, vec->size, value);
+  #else
+    for (size_t i = 0; i < vec->size; i++) {
+      vec->data[i] = value;
+    }
+  #endif /* VECTOR_SIMD */
+}
+
+#endif /* VECTOR_NUMERIC */
+
+#ifdef VECTOR_COMPARE
+
+/* Pattern defeating quicksort (Orson Peters), every comparison is VECTOR_COMPARE expanded in place instead of a qsort callback */
+#define VECTOR_SORT_INSERTION 24
+#define VECTOR_SORT_NINTHER   128
+#define VECTOR_SORT_PARTIAL   8
+#define VECTOR_SORT_BLOCK     64
+#define VECTOR_SWAP(a, b)     do { VECTOR_DATA_TYPE swap_ = *(a); *(a) = *(b); *(b) = swap_; } while(0)
+
+static void       fn_vector_sort_insertion(VECTOR_DATA_TYPE* begin, VECTOR_DATA_TYPE* end) {
+  if (begin == end) { return; }
+
+  for (VECTOR_DATA_TYPE* cur = begin + 1; cur != end; cur++) {
+    VECTOR_DATA_TYPE* sift = cur;
+    if (VECTOR_COMPARE(*sift, *(sift - 1))) {
+      VECTOR_DATA_TYPE tmp = *sift;
+      do {
+        *sift = *(sift - 1);
+        sift--;
+      } while (sift != begin && VECTOR_COMPARE(tmp, *(sift - 1)));
+      *sift = tmp;
+    }
+  }
+}
+/* Only for ranges with an element before begin that is not greater than any of them, it stops the sift without a bounds check */
+static void       fn_vector_sort_unguarded(VECTOR_DATA_TYPE* begin, VECTOR_DATA_TYPE* end) {
+  if (begin == end) { return; }
+
+  for (VECTOR_DATA_TYPE* cur = begin + 1; cur != end; cur++) {
+    VECTOR_DATA_TYPE* sift = cur;
+    if (VECTOR_COMPARE(*sift, *(sift - 1))) {
+      VECTOR_DATA_TYPE tmp = *sift;
+      do {
+        *sift = *(sift - 1);
+        sift--;
+      } while (VECTOR_COMPARE(tmp, *(sift - 1)));
+      *sift = tmp;
+    }
+  }
+}
+/* Insertion sort that gives up after VECTOR_SORT_PARTIAL moves, returns 1 when the range ended up sorted */
+static int        fn_vector_sort_partial(VECTOR_DATA_TYPE* begin, VECTOR_DATA_TYPE* end) {
+  if (begin == end) { return 1; }
+
+  size_t moves = 0;
+  for (VECTOR_DATA_TYPE* cur = begin + 1; cur != end; cur++) {
+    VECTOR_DATA_TYPE* sift = cur;
+    if (VECTOR_COMPARE(*sift, *(sift - 1))) {
+      VECTOR_DATA_TYPE tmp = *sift;
+      do {
+        *sift = *(sift - 1);
+        sift--;
+      } while (sift != begin && VECTOR_COMPARE(tmp, *(sift - 1)));
+      *sift  = tmp;
+      moves += (size_t)(cur - sift);
+    }
+    if (moves > VECTOR_SORT_PARTIAL) { return 0; }
+  }
+  return 1;
+}
+
+static void       fn_vector_sort_sift(VECTOR_DATA_TYPE* base, size_t root, size_t count) {
+  VECTOR_DATA_TYPE tmp = base[root];
+  for (size_t child = 2 * root + 1; child < count; child = 2 * root + 1) {
+    if (child + 1 < count && VECTOR_COMPARE(base[child], base[child + 1])) {
+      child++;
+    }
+    if (!VECTOR_COMPARE(tmp, base[child])) {
+      break;
+    }
+    base[root] = base[child];
+    root       = child;
+  }
+  base[root] = tmp;
+}
+/* Fallback once too many partitions were unbalanced, keeps the worst case at O(n log n) */
+static void       fn_vector_sort_heap(VECTOR_DATA_TYPE* begin, VECTOR_DATA_TYPE* end) {
+  size_t count = (size_t)(end - begin);
+  for (size_t i = count / 2; i-- > 0;) {
+    fn_vector_sort_sift(begin, i, count);
+  }
+  for (size_t i = count - 1; i > 0; i--) {
+    VECTOR_SWAP(&begin[0], &begin[i]);
+    fn_vector_sort_sift(begin, 0, i);
+  }
+}
+
+static void       fn_vector_sort3(VECTOR_DATA_TYPE* a, VECTOR_DATA_TYPE* b, VECTOR_DATA_TYPE* c) {
+  if (VECTOR_COMPARE(*b, *a)) { VECTOR_SWAP(a, b); }
+  if (VECTOR_COMPARE(*c, *b)) { VECTOR_SWAP(b, c); }
+  if (VECTOR_COMPARE(*b, *a)) { VECTOR_SWAP(a, b); }
+}
+
+#ifdef VECTOR_SORT_BRANCHLESS
+  /* Swaps first + offsets_l[i] with last - offsets_r[i], as a cyclic permutation unless the counts match (needed to stay O(n) on descending input) */
+  static void     fn_vector_swap_offsets(VECTOR_DATA_TYPE* first, VECTOR_DATA_TYPE* last, const unsigned char* offsets_l, const unsigned char* offsets_r, size_t count, int use_swaps) {
+    if (use_swaps) {
+      for (size_t i = 0; i < count; i++) {
+        VECTOR_SWAP(first + offsets_l[i], last - offsets_r[i]);
+      }
+    } else if (count > 0) {
+      VECTOR_DATA_TYPE* l   = first + offsets_l[0];
+      VECTOR_DATA_TYPE* r   = last - offsets_r[0];
+      VECTOR_DATA_TYPE  tmp = *l;
+      *l = *r;
+      for (size_t i = 1; i < count; i++) {
+        l  = first + offsets_l[i];
+        *r = *l;
+        r  = last - offsets_r[i];
+        *l = *r;
+      }
+      *r = tmp;
+    }
+  }
+#endif /* VECTOR_SORT_BRANCHLESS */
+
+/* Partitions around *begin, elements equal to the pivot go right. Sets already_partitioned when no element had to be swapped */
+static VECTOR_DATA_TYPE* fn_vector_partition_right(VECTOR_DATA_TYPE* begin, VECTOR_DATA_TYPE* end, int* already_partitioned) {
+  VECTOR_DATA_TYPE  pivot = *begin;
+  VECTOR_DATA_TYPE* first = begin;
+  VECTOR_DATA_TYPE* last  = end;
+
+  /* The median of 3 guarantees an element not less than the pivot on the right, so the first scan needs no bounds check */
+  while (VECTOR_COMPARE(*++first, pivot));
+  if (first - 1 == begin) {
+    while (first < last && !VECTOR_COMPARE(*--last, pivot));
+  } else {
+    while (!VECTOR_COMPARE(*--last, pivot));
+  }
+
+  *already_partitioned = first >= last;
+  #ifdef VECTOR_SORT_BRANCHLESS
+    /* BlockQuicksort (Edelkamp, Weiss), misplaced elements of a block from each side are recorded as offsets and swapped pairwise */
+    if (!*already_partitioned) {
+      VECTOR_SWAP(first, last);
+      first++;
+
+      unsigned char     offsets_l[VECTOR_SORT_BLOCK];
+      unsigned char     offsets_r[VECTOR_SORT_BLOCK];
+      VECTOR_DATA_TYPE* base_l  = first;
+      VECTOR_DATA_TYPE* base_r  = last;
+      size_t            num_l   = 0;
+      size_t            num_r   = 0;
+      size_t            start_l = 0;
+      size_t            start_r = 0;
+
+      while (first < last) {
+        size_t unknown     = (size_t)(last - first);
+        size_t left_split  = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+        size_t right_split = num_r == 0 ? unknown - left_split : 0;
+
+        left_split  = MIN(left_split, VECTOR_SORT_BLOCK);
+        right_split = MIN(right_split, VECTOR_SORT_BLOCK);
+        for (size_t i = 0; i < left_split; i++) {
+          offsets_l[num_l] = (unsigned char)i;
+          num_l += !VECTOR_COMPARE(*first, pivot);
+          first++;
+        }
+        for (size_t i = 0; i < right_split; i++) {
+          offsets_r[num_r] = (unsigned char)(i + 1);
+          last--;
+          num_r += VECTOR_COMPARE(*last, pivot) != 0;
+        }
+
+        size_t count = MIN(num_l, num_r);
+        fn_vector_swap_offsets(base_l, base_r, offsets_l + start_l, offsets_r + start_r, count, num_l == num_r);
+        num_l   -= count;
+        num_r   -= count;
+        start_l += count;
+        start_r += count;
+
+        if (num_l == 0) {
+          start_l = 0;
+          base_l  = first;
+        }
+        if (num_r == 0) {
+          start_r = 0;
+          base_r  = last;
+        }
+      }
+
+      /* One side still has misplaced elements, they are moved to the boundary */
+      if (num_l) {
+        while (num_l--) {
+          last--;
+          VECTOR_SWAP(base_l + offsets_l[start_l + num_l], last);
+        }
+        first = last;
+      }
+      if (num_r) {
+        while (num_r--) {
+          VECTOR_SWAP(base_r - offsets_r[start_r + num_r], first);
+          first++;
+        }
+      }
+    }
+  #else
+    while (first < last) {
+      VECTOR_SWAP(first, last);
+      while (VECTOR_COMPARE(*++first, pivot));
+      while (!VECTOR_COMPARE(*--last, pivot));
+    }
+  #endif /* VECTOR_SORT_BRANCHLESS */
+
+  VECTOR_DATA_TYPE* pivot_pos = first - 1;
+  *begin     = *pivot_pos;
+  *pivot_pos = pivot;
+  return pivot_pos;
+}
+/* Elements equal to the pivot go left, used when the pivot equals the element before the range so runs of equal keys are skipped at once */
+static VECTOR_DATA_TYPE* fn_vector_partition_left(VECTOR_DATA_TYPE* begin, VECTOR_DATA_TYPE* end) {
+  VECTOR_DATA_TYPE  pivot = *begin;
+  VECTOR_DATA_TYPE* first = begin;
+  VECTOR_DATA_TYPE* last  = end;
+
+  while (VECTOR_COMPARE(pivot, *--last));
+  if (last + 1 == end) {
+    while (first < last && !VECTOR_COMPARE(pivot, *++first));
+  } else {
+    while (!VECTOR_COMPARE(pivot, *++first));
+  }
+
+  while (first < last) {
+    VECTOR_SWAP(first, last);
+    while (VECTOR_COMPARE(pivot, *--last));
+    while (!VECTOR_COMPARE(pivot, *++first));
+  }
+
+  *begin = *last;
+  *last  = pivot;
+  return last;
+}
+
+/* Recurses into the left partition and loops on the right one, leftmost is 0 once an element before begin bounds the range */
+static void       fn_vector_sort_loop(VECTOR_DATA_TYPE* begin, VECTOR_DATA_TYPE* end, int bad_allowed, int leftmost) {
+  for (;;) {
+    size_t size = (size_t)(end - begin);
+    if (size < VECTOR_SORT_INSERTION) {
+      if (leftmost) {
+        fn_vector_sort_insertion(begin, end);
+      } else {
+        fn_vector_sort_unguarded(begin, end);
+      }
+      return;
+    }
+
+    /* Pivot to *begin, median of 3 or pseudo median of 9 (Tukey's ninther) for big ranges */
+    size_t half = size / 2;
+    if (size > VECTOR_SORT_NINTHER) {
+      fn_vector_sort3(begin, begin + half, end - 1);
+      fn_vector_sort3(begin + 1, begin + (half - 1), end - 2);
+      fn_vector_sort3(begin + 2, begin + (half + 1), end - 3);
+      fn_vector_sort3(begin + (half - 1), begin + half, begin + (half + 1));
+      VECTOR_SWAP(begin, begin + half);
+    } else {
+      fn_vector_sort3(begin + half, begin, end - 1);
+    }
+
+    if (!leftmost && !VECTOR_COMPARE(*(begin - 1), *begin)) {
+      begin = fn_vector_partition_left(begin, end) + 1;
+      continue;
+    }
+
+    int already_partitioned = 0;
+    VECTOR_DATA_TYPE* pivot_pos = fn_vector_partition_right(begin, end, &already_partitioned);
+    size_t left  = (size_t)(pivot_pos - begin);
+    size_t right = (size_t)(end - (pivot_pos + 1));
+
+    if (left < size / 8 || right < size / 8) {
+      if (--bad_allowed == 0) {
+        fn_vector_sort_heap(begin, end);
+        return;
+      }
+
+      /* Swaps a few elements around to break the pattern that produced the bad pivot */
+      if (left >= VECTOR_SORT_INSERTION) {
+        VECTOR_SWAP(begin, begin + left / 4);
+        VECTOR_SWAP(pivot_pos - 1, pivot_pos - left / 4);
+        if (left > VECTOR_SORT_NINTHER) {
+          VECTOR_SWAP(begin + 1, begin + (left / 4 + 1));
+          VECTOR_SWAP(begin + 2, begin + (left / 4 + 2));
+          VECTOR_SWAP(pivot_pos - 2, pivot_pos - (left / 4 + 1));
+          VECTOR_SWAP(pivot_pos - 3, pivot_pos - (left / 4 + 2));
+        }
+      }
+      if (right >= VECTOR_SORT_INSERTION) {
+        VECTOR_SWAP(pivot_pos + 1, pivot_pos + (1 + right / 4));
+        VECTOR_SWAP(end - 1, end - right / 4);
+        if (right > VECTOR_SORT_NINTHER) {
+          VECTOR_SWAP(pivot_pos + 2, pivot_pos + (2 + right / 4));
+          VECTOR_SWAP(pivot_pos + 3, pivot_pos + (3 + right / 4));
+          VECTOR_SWAP(end - 2, end - (1 + right / 4));
+          VECTOR_SWAP(end - 3, end - (2 + right / 4));
+        }
+      }
+    } else if (already_partitioned && fn_vector_sort_partial(begin, pivot_pos) && fn_vector_sort_partial(pivot_pos + 1, end)) {
+      /* A balanced partition that swapped nothing usually means (nearly) sorted input */
+      return;
+    }
+
+    fn_vector_sort_loop(begin, pivot_pos, bad_allowed, leftmost);
+    begin    = pivot_pos + 1;
+    leftmost = 0;
+  }
+}
+
+/* Not stable, O(n log n) worst case and O(n) for sorted, reversed or all equal input */
+void              fn_vector_sort(struct_vector* vec) {
+  BLOP_ASSERT_PTR(vec);
+
+  if (vec->size < 2) { return; }
+  fn_vector_sort_loop(vec->data, vec->data + vec->size, 64 - blop_clz64(vec->size), 1);
+}
+
+#undef VECTOR_SORT_INSERTION
+#undef VECTOR_SORT_NINTHER
+#undef VECTOR_SORT_PARTIAL
+#undef VECTOR_SORT_BLOCK
+#undef VECTOR_SWAP
+
+#endif /* VECTOR_COMPARE */
+
+#ifdef VECTOR_RADIX_KEY
+
+#define VECTOR_RADIX_DIGIT(x, d) ((size_t)((VECTOR_RADIX_KEY(x) >> ((d) * 8)) & 0xFF))
+
+/* Stable LSD radix sort on 8 bit digits, one counting pass for every digit then one scatter per digit that is not the same for all elements */
+void              fn_vector_radix_sort(struct_vector* vec) {
+  BLOP_ASSERT_PTR(vec);
+
+  size_t count = vec->size;
+  if (count < 2) { return; }
+
+  size_t histogram[sizeof(VECTOR_RADIX_KEY_TYPE)][256];
+  memset(histogram, 0, sizeof(histogram));
   for (size_t i = 0; i < count; i++) {
-    vec->data[idx + i] = value;
+    VECTOR_RADIX_KEY_TYPE key = VECTOR_RADIX_KEY(vec->data[i]);
+    for (size_t d = 0; d < sizeof(VECTOR_RADIX_KEY_TYPE); d++) {
+      histogram[d][(key >> (d * 8)) & 0xFF]++;
+    }
   }
+
+  VECTOR_DATA_TYPE* tmp = (VECTOR_DATA_TYPE*)MEM_MALLOC(count * sizeof(VECTOR_DATA_TYPE));
+  ASSERT_MALLOC(tmp, VECTOR_DATA_TYPE, count * sizeof(VECTOR_DATA_TYPE));
+
+  VECTOR_DATA_TYPE* src = vec->data;
+  VECTOR_DATA_TYPE* dst = tmp;
+  for (size_t d = 0; d < sizeof(VECTOR_RADIX_KEY_TYPE); d++) {
+    size_t* offsets = histogram[d];
+    if (offsets[VECTOR_RADIX_DIGIT(src[0], d)] == count) {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (size_t b = 0; b < 256; b++) {
+      size_t bucket = offsets[b];
+      offsets[b]    = offset;
+      offset       += bucket;
+    }
+    for (size_t i = 0; i < count; i++) {
+      dst[offsets[VECTOR_RADIX_DIGIT(src[i], d)]++] = src[i];
+    }
+
+    VECTOR_DATA_TYPE* swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != vec->data) {
+    memcpy(vec->data, src, count * sizeof(VECTOR_DATA_TYPE));
+  }
+  FREE(tmp);
 }
 
+#undef VECTOR_RADIX_DIGIT
+
+#endif /* VECTOR_RADIX_KEY */
+
 #endif /* VECTOR_IMPLEMENTATION */
 
 #ifdef __cplusplus
@@ -362,7 +1073,21 @@ void              fn_vector_memset(struct_vector* vec, size_t idx, VECTOR_DATA_T
 #undef VECTOR_INITIAL_SIZE
 #undef VECTOR_SHRINK_POLICIE
 #undef VECTOR_RESIZE_POLICIE
+#undef VECTOR_SHRINK_TARGET
+#undef VECTOR_NO_AUTO_SHRINK
 #undef VECTOR_DEALLOCATE_DATA
+#undef VECTOR_CLEAR_RELEASE
+#undef VECTOR_INLINE_CAPACITY
+#undef VECTOR_CHECK
+#undef VECTOR_NUMERIC
+#undef VECTOR_SIMD
+#undef VECTOR_SIMD_TYPE
+#undef VECTOR_SIMD_FN
+#undef VECTOR_SUM_TYPE
+#undef VECTOR_COMPARE
+#undef VECTOR_RADIX_KEY
+#undef VECTOR_RADIX_KEY_TYPE
+#undef VECTOR_SORT_BRANCHLESS
 
 #undef VECTOR_STRUCT
 #undef VECTOR_NOT_STRUCT
@@ -385,8 +1110,15 @@ void              fn_vector_memset(struct_vector* vec, size_t idx, VECTOR_DATA_T
 
 #undef fn_vector_set       
 #undef fn_vector_get       
+#undef fn_vector_at
+#undef fn_vector_set_unchecked
+#undef fn_vector_get_unchecked
 #undef fn_vector_resize    
+#undef fn_vector_reserve
+#undef fn_vector_resize_uninit
 #undef fn_vector_shrink
+#undef fn_vector_shrink_to_fit
+#undef fn_vector_grow
 
 #undef fn_vector_clear     
 #undef fn_vector_erase     
@@ -397,5 +1129,30 @@ void              fn_vector_memset(struct_vector* vec, size_t idx, VECTOR_DATA_T
 #undef fn_vector_push_back 
 #undef fn_vector_push_front
 
+#undef fn_vector_append
+#undef fn_vector_insert_range
+#undef fn_vector_extend_from
+
 #undef fn_vector_memcpy    
-#undef fn_vector_memset
\ No newline at end of file
+#undef fn_vector_memset
+
+#undef fn_vector_find
+#undef fn_vector_count
+#undef fn_vector_min
+#undef fn_vector_max
+#undef fn_vector_sum
+#undef fn_vector_dot
+#undef fn_vector_fill
+
+#undef fn_vector_sort
+#undef fn_vector_sort_loop
+#undef fn_vector_sort_insertion
+#undef fn_vector_sort_unguarded
+#undef fn_vector_sort_partial
+#undef fn_vector_sort_heap
+#undef fn_vector_sort_sift
+#undef fn_vector_sort3
+#undef fn_vector_partition_left
+#undef fn_vector_partition_right
+#undef fn_vector_swap_offsets
+#undef fn_vector_radix_sort
\ No newline at end of file
@@ -0,0 +1,105 @@
+#define LOG_COLOURED
+#define MEM_MALLOC(size)        blop_alloc((size))
+#define MEM_CALLOC(count, size) blop_calloc((count), (size))
+#define MEM_REALLOC(ptr, size)  blop_realloc((ptr), (size))
+#define MEM_FREE(ptr)           blop_free((ptr))
+#include <blop/blop.h>
+
+#define ALLOC_IMPLEMENTATION
+#include <blop/alloc.h>
+
+#define VECTOR_NAME           Vecsize
+#define VECTOR_FN_PREFIX      vecsize
+#define VECTOR_DATA_TYPE      size_t
+#define VECTOR_STRUCT
+#define VECTOR_IMPLEMENTATION
+#include <blop/vector.h>
+
+#define ALLOCATIONS 20000
+
+uint8_t* ptrs[ALLOCATIONS];
+size_t   sizes[ALLOCATIONS];
+
+static void fill(uint8_t* ptr, size_t size, size_t seed) {
+  for (size_t i = 0; i < size; i++) {
+    ptr[i] = (uint8_t)(seed + i);
+  }
+}
+static int check(uint8_t* ptr, size_t size, size_t seed) {
+  for (size_t i = 0; i < size; i++) {
+    if (ptr[i] != (uint8_t)(seed + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  ANSI_ENABLE();
+
+  blop_alloc_init();
+
+  uint64_t seed = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < ALLOCATIONS; i++) {
+    seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+    sizes[i] = (i % 100 == 0) ? (size_t)(seed % 200000) + 1 : (size_t)(seed % 2048) + 1;
+    ptrs[i]  = (uint8_t*)blop_alloc(sizes[i]);
+    ASSERT(((uintptr_t)ptrs[i] & 15) == 0, "Allocation is not 16 byte aligned");
+    ASSERT(blop_alloc_usable(ptrs[i]) >= sizes[i], "Allocation is smaller than requested");
+    fill(ptrs[i], sizes[i], i);
+  }
+  ASSERT(blop_alloc_size() == ALLOCATIONS, "Allocation count mismatch");
+  LOG_SUCCESS("Objects allocated");
+
+  for (size_t i = 0; i < ALLOCATIONS; i++) {
+    ASSERT(check(ptrs[i], sizes[i], i), "Object was overwritten");
+  }
+  LOG_SUCCESS("Objects verified");
+
+  for (size_t i = 0; i < ALLOCATIONS; i += 2) {
+    size_t size = sizes[i] * 3 + 1;
+    ptrs[i] = (uint8_t*)blop_realloc(ptrs[i], size);
+    ASSERT(check(ptrs[i], sizes[i], i), "Realloc lost the object contents");
+    fill(ptrs[i], size, i);
+    sizes[i] = size;
+  }
+  for (size_t i = 0; i < ALLOCATIONS; i++) {
+    ASSERT(check(ptrs[i], sizes[i], i), "Object was overwritten after realloc");
+  }
+  LOG_SUCCESS("Objects reallocated");
+
+  blop_alloc_print_out();
+
+  AllocStats stats;
+  blop_alloc_stats(&stats);
+  size_t live = stats.large_count;
+  for (size_t i = 0; i < ALLOC_CLASSES_COUNT; i++) {
+    live += stats.classes[i].live;
+    ASSERT(stats.classes[i].block_bytes <= stats.classes[i].blocks * ALLOC_BLOCK_BYTES, "Class blocks do not fit their alignment");
+  }
+  ASSERT(live == ALLOCATIONS && stats.classes[0].size == 16, "Alloc stats mismatch");
+  blop_alloc_dump_out();
+  LOG_SUCCESS("Alloc stats collected");
+
+  for (size_t i = 0; i < ALLOCATIONS; i++) {
+    blop_free(ptrs[i]);
+  }
+  ASSERT(blop_alloc_size() == 0 && blop_alloc_bytes() == 0, "Objects leaked");
+  LOG_SUCCESS("Objects freed");
+
+  Vecsize* vec = vecsize_create(NULL);
+  for (size_t i = 0; i < 100000; i++) {
+    vecsize_push_back(vec, i);
+  }
+  for (size_t i = 0; i < 100000; i++) {
+    ASSERT(vecsize_get(vec, i) == i, "Vector lost its contents");
+  }
+  ASSERT(blop_alloc_size() == 2, "Vector is not allocating through blop_alloc");
+  vecsize_clear(vec);
+  vecsize_destroy(vec);
+  ASSERT(blop_alloc_size() == 0, "Vector leaked through blop_alloc");
+  LOG_SUCCESS("Vector allocated through blop_alloc");
+
+  ANSI_DISABLE();
+  return 0;
+}
@@ -3,4 +3,13 @@
 :: gcc -O3 -g -I.. list.c -o list.exe
 :: gcc -O3 -g -I.. pool.c -o pool.exe
 :: gcc -O3 -g -I.. vector.c -o vector.exe
+:: gcc -O3 -g -I.. deque.c -o deque.exe
+:: gcc -O3 -g -I.. slab.c -o slab.exe
+:: gcc -O3 -g -I.. slab_bench.c -o slab_bench.exe
+:: gcc -O3 -g -I.. slab_threads.c -lpthread -o slab_threads.exe
+:: gcc -O3 -g -I.. slab_lockfree.c -lpthread -o slab_lockfree.exe
+:: gcc -O3 -g -I.. slab_remote.c -lpthread -o slab_remote.exe
+:: gcc -O3 -g -I.. pages.c -o pages.exe
+:: gcc -O3 -g -I.. alloc.c -o alloc.exe
+:: gcc -O3 -g -I.. slotmap.c -o slotmap.exe
 gcc -O3 -g -I.. -IC:/Dev/Libs/cJSON-1.7.19 -IC:/Dev/Libs/curl-8.17.0_5-win64-mingw/include -LC:/Dev/Libs/curl-8.17.0_5-win64-mingw/lib openai.c C:/Dev/Libs/cJSON-1.7.19/cJSON/cJSON.c -lcurl -o openai.exe
\ No newline at end of file
@@ -0,0 +1,109 @@
+#define LOG_COLOURED
+#include <blop/blop.h>
+#include <time.h>
+
+#define DEQUE_NAME      Dequeint
+#define DEQUE_FN_PREFIX dequeint
+#define DEQUE_DATA_TYPE int
+#define DEQUE_STRUCT
+#define DEQUE_IMPLEMENTATION
+#include <blop/deque.h>
+
+#define VECTOR_NAME      Vecint
+#define VECTOR_FN_PREFIX vecint
+#define VECTOR_DATA_TYPE int
+#define VECTOR_STRUCT
+#define VECTOR_IMPLEMENTATION
+#include <blop/vector.h>
+
+#define ELEMENTS 100000
+#define BACKLOG  50000
+
+int buffer[ELEMENTS];
+
+static double now_ns() {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main() {
+  ANSI_ENABLE();
+
+  Dequeint* deque = dequeint_create(NULL);
+  LOG_SUCCESS("Deque created");
+
+  for (int i = 0; i < ELEMENTS; i++) {
+    if (i % 2) {
+      dequeint_push_back(deque, i);
+    } else {
+      dequeint_push_front(deque, -i);
+    }
+  }
+  ASSERT(dequeint_size(deque) == ELEMENTS && (deque->capacity & (deque->capacity - 1)) == 0, "Deque size mismatch after push");
+  ASSERT(dequeint_front(deque) == -(ELEMENTS - 2) && dequeint_back(deque) == ELEMENTS - 1, "Deque ends mismatch");
+  for (int i = 0; i < ELEMENTS / 2; i++) {
+    ASSERT(dequeint_get(deque, ELEMENTS / 2 + i) == 2 * i + 1, "Deque lost its order while growing");
+  }
+  LOG_SUCCESS("Elements pushed at both ends");
+
+  for (int i = 0; i < ELEMENTS / 2; i++) {
+    dequeint_pop_front(deque);
+  }
+  ASSERT(dequeint_front(deque) == 1, "Pop front mismatch");
+  dequeint_pop_back(deque);
+  ASSERT(dequeint_back(deque) == ELEMENTS - 3, "Pop back mismatch");
+  LOG_SUCCESS("Elements popped at both ends");
+
+  dequeint_clear(deque);
+  for (int i = 0; i < ELEMENTS; i++) {
+    buffer[i] = i;
+  }
+  /* Leave the head in the middle so the writes and reads wrap around */
+  for (size_t i = 0; i < deque->capacity / 2 + 3; i++) {
+    dequeint_push_back(deque, 0);
+    dequeint_pop_front(deque);
+  }
+  dequeint_write(deque, buffer, ELEMENTS);
+  int*   first  = NULL;
+  int*   second = NULL;
+  size_t count  = 0;
+  size_t spans  = dequeint_spans(deque, &first, &second, &count);
+  ASSERT(spans + count == ELEMENTS && first[0] == 0 && (count == 0 || second[0] == (int)spans), "Deque spans mismatch");
+  memset(buffer, 0, sizeof(buffer));
+  ASSERT(dequeint_read(deque, buffer, 2 * ELEMENTS) == ELEMENTS && dequeint_size(deque) == 0, "Deque read mismatch");
+  for (int i = 0; i < ELEMENTS; i++) {
+    ASSERT(buffer[i] == i, "Deque bulk copy lost its order");
+  }
+  LOG_SUCCESS("Elements copied in bulk");
+
+  /* A work queue under backlog: the vector memmoves the whole backlog on every pop_front */
+  Vecint* vec = vecint_create(NULL);
+  double start = now_ns();
+  for (int i = 0; i < ELEMENTS; i++) {
+    vecint_push_back(vec, i);
+    if (i >= BACKLOG) {
+      vecint_pop_front(vec);
+    }
+  }
+  double vectored = now_ns() - start;
+  start = now_ns();
+  for (int i = 0; i < ELEMENTS; i++) {
+    dequeint_push_back(deque, i);
+    if (i >= BACKLOG) {
+      dequeint_pop_front(deque);
+    }
+  }
+  double dequeued = now_ns() - start;
+  ASSERT(dequeint_front(deque) == vecint_front(vec), "Deque and vector queues disagree");
+  printf("FIFO with a backlog of %d: vector %.2f ms, deque %.2f ms\n", BACKLOG, vectored / 1e6, dequeued / 1e6);
+
+  vecint_clear(vec);
+  vecint_destroy(vec);
+  dequeint_clear(deque);
+  dequeint_destroy(deque);
+  LOG_SUCCESS("Deque destroyed");
+
+  ANSI_DISABLE();
+  return 0;
+}
@@ -0,0 +1,104 @@
+#define LOG_COLOURED
+#include <blop/blop.h>
+#include <time.h>
+
+#define PAGES_NAME      Pages
+#define PAGES_FN_PREFIX pages
+#define PAGES_STRUCT
+#define PAGES_IMPLEMENTATION
+#include <blop/pages.h>
+
+typedef struct Particle {
+  double position[3];
+  double velocity[3];
+  uint64_t id;
+  uint8_t  payload[200];
+} Particle;
+
+Pages pages;
+
+#define SLAB_NAME        MapSlab
+#define SLAB_FN_PREFIX   map_slab
+#define SLAB_DATA_TYPE   Particle
+#define SLAB_BLOCK_ALLOC(size, align) pages_alloc(&pages, (size), (align))
+#define SLAB_BLOCK_FREE(ptr, size)    pages_free(&pages, (ptr), (size))
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define SLAB_NAME        HeapSlab
+#define SLAB_FN_PREFIX   heap_slab
+#define SLAB_DATA_TYPE   Particle
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define OBJECTS 100000
+
+Particle* ptrs[OBJECTS];
+
+static double now_ns() {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main() {
+  ANSI_ENABLE();
+
+  pages_create(&pages);
+  MapSlab* slab = map_slab_create(NULL);
+  LOG_SUCCESS("Slab created on top of pages");
+
+  double start = now_ns();
+  for (size_t i = 0; i < OBJECTS; i++) {
+    ptrs[i] = map_slab_alloc(slab);
+    ptrs[i]->id = i;
+  }
+  double mapped = now_ns() - start;
+
+  for (size_t i = 0; i < OBJECTS; i++) {
+    ASSERT(ptrs[i]->id == i, "Object was overwritten");
+  }
+  LOG_SUCCESS("Objects allocated and verified");
+
+  size_t bytes = pages_bytes(&pages);
+  for (size_t i = 0; i < OBJECTS; i++) {
+    map_slab_free(slab, ptrs[i]);
+  }
+  size_t reclaimed = map_slab_trim(slab, 0);
+  ASSERT(reclaimed > 0 && pages.live == 0, "Trim did not give the blocks back to the pages");
+  LOG_SUCCESS("Blocks released to the pages");
+
+  for (size_t i = 0; i < OBJECTS; i++) {
+    ptrs[i] = map_slab_alloc(slab);
+    ptrs[i]->id = i;
+  }
+  ASSERT(pages_bytes(&pages) == bytes, "Released blocks were not reused");
+  for (size_t i = 0; i < OBJECTS; i++) {
+    map_slab_free(slab, ptrs[i]);
+  }
+  LOG_SUCCESS("Released blocks reused");
+
+  HeapSlab* heap = heap_slab_create(NULL);
+  start = now_ns();
+  for (size_t i = 0; i < OBJECTS; i++) {
+    ptrs[i] = heap_slab_alloc(heap);
+    ptrs[i]->id = i;
+  }
+  double heaped = now_ns() - start;
+  for (size_t i = 0; i < OBJECTS; i++) {
+    heap_slab_free(heap, ptrs[i]);
+  }
+  heap_slab_destroy(heap);
+
+  printf("First touch of %d objects: pages %.2f ms, aligned heap %.2f ms\n", OBJECTS, mapped / 1e6, heaped / 1e6);
+  pages_print_out(&pages);
+
+  map_slab_destroy(slab);
+  pages_destroy(&pages);
+  LOG_SUCCESS("Pages destroyed");
+
+  ANSI_DISABLE();
+  return 0;
+}
@@ -0,0 +1,197 @@
+#define LOG_COLOURED
+#include <blop/blop.h>
+
+#define SLAB_NAME      Slab
+#define SLAB_FN_PREFIX slab
+#define SLAB_DATA_TYPE int
+#define SLAB_STATS
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define SLAB_NAME      AutoSlab
+#define SLAB_FN_PREFIX auto_slab
+#define SLAB_DATA_TYPE int
+#define SLAB_TRIM_AUTO
+#define SLAB_TRIM_LOW  1
+#define SLAB_TRIM_HIGH 2
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define SLAB_NAME             PaddedSlab
+#define SLAB_FN_PREFIX        padded_slab
+#define SLAB_DATA_TYPE        int
+#define SLAB_PAD_TO_CACHELINE
+#define SLAB_STATS
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+typedef struct Buffer {
+  char*  data;
+  size_t uses;
+} Buffer;
+
+size_t constructed = 0;
+size_t destructed  = 0;
+
+static void buffer_construct(Buffer* buffer) {
+  buffer->data = (char*)malloc(256);
+  buffer->uses = 0;
+  constructed++;
+}
+static void buffer_destruct(Buffer* buffer) {
+  free(buffer->data);
+  destructed++;
+}
+
+#define SLAB_NAME           CachedSlab
+#define SLAB_FN_PREFIX      cached_slab
+#define SLAB_DATA_TYPE      Buffer
+#define SLAB_CONSTRUCT(ptr) buffer_construct((ptr))
+#define SLAB_DESTRUCT(ptr)  buffer_destruct((ptr))
+#define SLAB_OBJECTS_COUNT  64
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define OBJECTS 5000
+#define BUFFERS 4096
+
+Buffer* buffers[BUFFERS];
+
+int* ptrs[OBJECTS];
+
+static void count_object(int* ptr, void* ctx) {
+  ASSERT(*ptr >= 0 && *ptr < OBJECTS, "Foreach visited a free object");
+  (*(size_t*)ctx)++;
+}
+
+int main() {
+  ANSI_ENABLE();
+
+  Slab* slab = slab_create(NULL);
+  LOG_SUCCESS("Slab created");
+
+  for (int i = 0; i < OBJECTS; i++) {
+    ptrs[i] = slab_alloc(slab);
+    *ptrs[i] = i;
+  }
+  ASSERT(slab_size(slab) == OBJECTS, "Slab size mismatch after alloc");
+  LOG_SUCCESS("Objects allocated");
+
+  for (int i = 0; i < OBJECTS; i++) {
+    ASSERT(*ptrs[i] == i, "Object was overwritten");
+  }
+  LOG_SUCCESS("Objects verified");
+
+  for (int i = 0; i < OBJECTS; i += 2) {
+    slab_free(slab, ptrs[i]);
+  }
+  for (int i = 0; i < OBJECTS; i += 2) {
+    ptrs[i] = slab_alloc(slab);
+    *ptrs[i] = i;
+  }
+  ASSERT(slab_size(slab) == OBJECTS, "Slab size mismatch after realloc");
+  LOG_SUCCESS("Objects reused");
+
+  for (int i = 0; i < OBJECTS; i++) {
+    slab_free(slab, ptrs[i]);
+  }
+  LOG_SUCCESS("Objects freed");
+
+  for (int i = 0; i < OBJECTS; i++) {
+    ptrs[i] = slab_alloc(slab);
+  }
+  size_t blocks = slab->blocks;
+  slab_reset(slab);
+  ASSERT(slab_size(slab) == 0, "Slab size mismatch after reset");
+  for (int i = 0; i < OBJECTS; i++) {
+    ptrs[i] = slab_alloc(slab);
+  }
+  ASSERT(slab->blocks == blocks, "Reset did not rewind the blocks");
+  slab_reset(slab);
+  LOG_SUCCESS("Slab reset");
+
+  Slab_stats stats;
+  slab_stats(slab, &stats);
+  size_t bytes = stats.block_bytes;
+  size_t reclaimed = slab_trim(slab, 1);
+  slab_stats(slab, &stats);
+  ASSERT(slab->blocks == 1 && reclaimed == bytes - stats.block_bytes, "Trim did not free the empty blocks");
+  LOG_SUCCESS("Slab trimmed");
+
+  AutoSlab* auto_slab = auto_slab_create(NULL);
+  for (int i = 0; i < OBJECTS; i++) {
+    ptrs[i] = auto_slab_alloc(auto_slab);
+  }
+  for (int i = 0; i < OBJECTS; i++) {
+    auto_slab_free(auto_slab, ptrs[i]);
+  }
+  ASSERT(auto_slab->blocks <= 2, "Automatic trim kept too many empty blocks");
+  auto_slab_destroy(auto_slab);
+  LOG_SUCCESS("Slab trimmed automatically");
+
+  slab_alloc_n(slab, ptrs, OBJECTS);
+  for (int i = 0; i < OBJECTS; i++) {
+    *ptrs[i] = i;
+  }
+  ASSERT(slab_size(slab) == OBJECTS, "Slab size mismatch after bulk alloc");
+  size_t visited = 0;
+  slab_foreach(slab, count_object, &visited);
+  ASSERT(visited == OBJECTS, "Foreach did not visit every live object");
+  slab_free_n(slab, ptrs, OBJECTS);
+  ASSERT(slab_size(slab) == 0, "Slab size mismatch after bulk free");
+  LOG_SUCCESS("Objects allocated and freed in bulk");
+
+  slab_stats(slab, &stats);
+  ASSERT(stats.live == 0 && stats.peak == OBJECTS && stats.allocs == stats.frees, "Slab counters mismatch");
+  ASSERT(stats.histogram[0] == stats.blocks && stats.capacity_min >= 64 && stats.capacity_max == 1024, "Slab occupancy mismatch");
+  slab_dump_out(slab);
+  LOG_SUCCESS("Slab stats collected");
+
+  PaddedSlab* padded = padded_slab_create(NULL);
+  padded_slab_alloc_n(padded, ptrs, OBJECTS);
+  for (int i = 0; i < OBJECTS; i++) {
+    ASSERT((uintptr_t)ptrs[i] % CACHE_LINE_SIZE == 0, "Padded object is not cache line aligned");
+  }
+  /* 1024 padded objects would not fit in the capped block alignment, so blocks stop growing before that */
+  PaddedSlab_stats padded_stats;
+  padded_slab_stats(padded, &padded_stats);
+  ASSERT(padded_stats.capacity_max < 1024 && padded_stats.block_bytes <= padded_stats.blocks * ((size_t)64 << 10), "Padded blocks grew past the block alignment");
+  padded_slab_free_n(padded, ptrs, OBJECTS);
+  padded_slab_destroy(padded);
+  LOG_SUCCESS("Objects padded to cache lines");
+
+  CachedSlab* cached = cached_slab_create(NULL);
+  size_t uses = 0;
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < BUFFERS; i++) {
+      buffers[i] = cached_slab_alloc(cached);
+      ASSERT(buffers[i]->data, "Object was handed out unconstructed");
+      buffers[i]->uses++;
+    }
+    for (int i = 0; i < BUFFERS; i++) {
+      uses += buffers[i]->uses;
+      cached_slab_free(cached, buffers[i]);
+    }
+    if (round == 1) {
+      cached_slab_alloc_n(cached, buffers, BUFFERS);
+      cached_slab_reset(cached);
+    }
+  }
+  /* Every object kept its use count, so it was built once and reused as it was left */
+  ASSERT(constructed == BUFFERS && uses == (size_t)BUFFERS * (1 + 2 + 3), "Freed objects were constructed again");
+  cached_slab_destroy(cached);
+  ASSERT(destructed == constructed, "Objects were not destructed with their blocks");
+  LOG_SUCCESS("Objects kept constructed across reuse");
+
+  slab_print_out(slab);
+
+  slab_destroy(slab);
+  LOG_SUCCESS("Slab destroyed");
+
+  ANSI_DISABLE();
+  return 0;
+}
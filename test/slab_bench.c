@@ -0,0 +1,97 @@
+#include <blop/blop.h>
+#include <time.h>
+
+#define SLAB_NAME      Slab
+#define SLAB_FN_PREFIX slab
+#define SLAB_DATA_TYPE int
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define ITERATIONS 1000000
+
+static double now_ns() {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* Fills `count` objects, opens a single hole in the last allocated object and times alloc/free pairs on it.
+ * Blocks grow geometrically, so the number of blocks the fill took is reported through `blocks` */
+static double bench(size_t count, size_t* blocks) {
+  Slab* slab = slab_create(NULL);
+
+  int** ptrs = NULL;
+  CALLOC(ptrs, int*, count);
+  for (size_t i = 0; i < count; i++) {
+    ptrs[i] = slab_alloc(slab);
+  }
+  *blocks = slab->blocks;
+
+  slab_free(slab, ptrs[count - 1]);
+
+  double start = now_ns();
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    int* ptr = slab_alloc(slab);
+    *ptr = (int)i;
+    slab_free(slab, ptr);
+  }
+  double elapsed = now_ns() - start;
+
+  ptrs[count - 1] = slab_alloc(slab);
+  for (size_t i = 0; i < count; i++) {
+    slab_free(slab, ptrs[i]);
+  }
+  FREE(ptrs);
+  slab_destroy(slab);
+
+  return elapsed / ITERATIONS;
+}
+
+/* Allocates and frees `count` objects per round, one by one or with a single bulk call */
+static double bench_bulk(size_t count, int bulk) {
+  Slab* slab = slab_create(NULL);
+  int** ptrs = NULL;
+  CALLOC(ptrs, int*, count);
+
+  size_t rounds = ITERATIONS / count;
+  double start  = now_ns();
+  for (size_t r = 0; r < rounds; r++) {
+    if (bulk) {
+      slab_alloc_n(slab, ptrs, count);
+      slab_free_n(slab, ptrs, count);
+    } else {
+      for (size_t i = 0; i < count; i++) {
+        ptrs[i] = slab_alloc(slab);
+      }
+      for (size_t i = 0; i < count; i++) {
+        slab_free(slab, ptrs[i]);
+      }
+    }
+  }
+  double elapsed = now_ns() - start;
+
+  FREE(ptrs);
+  slab_destroy(slab);
+  return elapsed / (double)(rounds * count);
+}
+
+int main() {
+  size_t objects[] = { 1024, 16384, 262144, 1048576, 4194304 };
+
+  printf("%10s %10s %16s\n", "objects", "blocks", "ns/alloc+free");
+  for (size_t i = 0; i < sizeof(objects) / sizeof(objects[0]); i++) {
+    size_t blocks = 0;
+    double ns     = bench(objects[i], &blocks);
+    printf("%10zu %10zu %16.2f\n", objects[i], blocks, ns);
+  }
+
+  size_t counts[] = { 16, 256, 4096, 65536 };
+
+  printf("\n%10s %16s %16s\n", "batch", "single ns/obj", "bulk ns/obj");
+  for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+    printf("%10zu %16.2f %16.2f\n", counts[i], bench_bulk(counts[i], false), bench_bulk(counts[i], true));
+  }
+
+  return 0;
+}
@@ -0,0 +1,136 @@
+#define ENABLE_RWLOCK
+#include <blop/blop.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+typedef struct Message {
+  uint64_t token;
+  uint64_t check;
+} Message;
+
+#define SLAB_NAME      LockSlab
+#define SLAB_FN_PREFIX lock_slab
+#define SLAB_DATA_TYPE Message
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define SLAB_NAME      FreeSlab
+#define SLAB_FN_PREFIX free_slab
+#define SLAB_DATA_TYPE Message
+#define SLAB_LOCKFREE
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define MAX_THREADS 8
+#define ITERATIONS  200000
+#define SLOTS       4096
+
+LockSlab lock_pool;
+FreeSlab free_pool;
+
+/* Objects are exchanged through shared slots so most of them are freed by a different thread than the one that allocated them */
+_Atomic(Message*) slots[SLOTS];
+
+static double now_ns() {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void check(Message* msg) {
+  ASSERT(msg->check == ~msg->token, "Message was handed to two owners at the same time");
+}
+
+static void* lock_worker(void* arg) {
+  uint64_t seed = (uint64_t)(uintptr_t)arg * 0x9E3779B97F4A7C15ULL + 1;
+  for (uint64_t i = 0; i < ITERATIONS; i++) {
+    seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+
+    lock_slab_wrlock(&lock_pool);
+    Message* msg = lock_slab_alloc(&lock_pool);
+    lock_slab_wrunlock(&lock_pool);
+
+    msg->token = seed;
+    msg->check = ~seed;
+
+    Message* old = atomic_exchange(&slots[seed % SLOTS], msg);
+    if (old) {
+      check(old);
+      lock_slab_wrlock(&lock_pool);
+      lock_slab_free(&lock_pool, old);
+      lock_slab_wrunlock(&lock_pool);
+    }
+  }
+  return NULL;
+}
+static void* free_worker(void* arg) {
+  uint64_t seed = (uint64_t)(uintptr_t)arg * 0x9E3779B97F4A7C15ULL + 1;
+  for (uint64_t i = 0; i < ITERATIONS; i++) {
+    seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+
+    Message* msg = free_slab_alloc(&free_pool);
+    msg->token = seed;
+    msg->check = ~seed;
+
+    Message* old = atomic_exchange(&slots[seed % SLOTS], msg);
+    if (old) {
+      check(old);
+      free_slab_free(&free_pool, old);
+    }
+  }
+  return NULL;
+}
+
+static double run(void* (*worker)(void*), size_t threads) {
+  pthread_t ids[MAX_THREADS];
+
+  double start = now_ns();
+  for (size_t i = 0; i < threads; i++) {
+    pthread_create(&ids[i], NULL, worker, (void*)(uintptr_t)(i + 1));
+  }
+  for (size_t i = 0; i < threads; i++) {
+    pthread_join(ids[i], NULL);
+  }
+  double elapsed = now_ns() - start;
+
+  return (double)(threads * ITERATIONS) / elapsed * 1e3;
+}
+
+int main() {
+  lock_slab_create(&lock_pool);
+  free_slab_create(&free_pool);
+
+  printf("%8s %14s %14s\n", "threads", "rwlock Mop/s", "lockfree Mop/s");
+  for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    double locked = run(lock_worker, threads);
+    for (size_t i = 0; i < SLOTS; i++) {
+      Message* msg = atomic_exchange(&slots[i], NULL);
+      if (msg) {
+        check(msg);
+        lock_slab_free(&lock_pool, msg);
+      }
+    }
+
+    double lockfree = run(free_worker, threads);
+    for (size_t i = 0; i < SLOTS; i++) {
+      Message* msg = atomic_exchange(&slots[i], NULL);
+      if (msg) {
+        check(msg);
+        free_slab_free(&free_pool, msg);
+      }
+    }
+
+    printf("%8zu %14.2f %14.2f\n", threads, locked, lockfree);
+  }
+
+  ASSERT(lock_slab_size(&lock_pool) == 0, "Locked slab leaked objects");
+  ASSERT(free_slab_size(&free_pool) == 0, "Lock free slab leaked objects");
+  LOG_SUCCESS("Stress test passed");
+
+  free_slab_destroy(&free_pool);
+  lock_slab_destroy(&lock_pool);
+  return 0;
+}
@@ -0,0 +1,202 @@
+#define ENABLE_RWLOCK
+#include <blop/blop.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+typedef struct Message {
+  uint64_t id;
+  uint64_t payload[7];
+} Message;
+
+#define SLAB_NAME      LockSlab
+#define SLAB_FN_PREFIX lock_slab
+#define SLAB_DATA_TYPE Message
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define SLAB_NAME      RemoteSlab
+#define SLAB_FN_PREFIX remote_slab
+#define SLAB_DATA_TYPE Message
+#define SLAB_REMOTE_FREE
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+/* Objects owning heap memory, the freeing thread must release it before the queue link overwrites the pointer */
+typedef struct Owned {
+  int* value;
+} Owned;
+
+_Atomic size_t released;
+
+#define SLAB_NAME                  OwnedSlab
+#define SLAB_FN_PREFIX             owned_slab
+#define SLAB_DATA_TYPE             Owned
+#define SLAB_REMOTE_FREE
+#define SLAB_DEALLOCATE_DATA(ptr)  do { free((ptr)->value); atomic_fetch_add(&released, 1); } while(0)
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define MAX_WORKERS 4
+#define MESSAGES    400000
+#define RING        1024
+
+/* One single producer single consumer ring per worker, the I/O thread (main) is the only producer */
+typedef struct Ring {
+  Message*          slots[RING];
+  _Atomic size_t    head;
+  _Atomic size_t    tail;
+} Ring;
+
+Ring       rings[MAX_WORKERS];
+LockSlab   lock_pool;
+RemoteSlab remote_pool;
+int        use_remote;
+
+static double now_ns() {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void ring_push(Ring* ring, Message* msg) {
+  size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  while (tail - atomic_load_explicit(&ring->head, memory_order_acquire) == RING) {
+    sched_yield();
+  }
+  ring->slots[tail % RING] = msg;
+  atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+static Message* ring_pop(Ring* ring) {
+  size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  while (head == atomic_load_explicit(&ring->tail, memory_order_acquire)) {
+    sched_yield();
+  }
+  Message* msg = ring->slots[head % RING];
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+  return msg;
+}
+
+static void* worker(void* arg) {
+  Ring* ring = (Ring*)arg;
+  for (;;) {
+    Message* msg = ring_pop(ring);
+    if (!msg) {
+      return NULL;
+    }
+    ASSERT(msg->payload[6] == msg->id * 7, "Message was overwritten");
+
+    if (use_remote) {
+      remote_slab_free(&remote_pool, msg);
+    } else {
+      lock_slab_wrlock(&lock_pool);
+      lock_slab_free(&lock_pool, msg);
+      lock_slab_wrunlock(&lock_pool);
+    }
+  }
+}
+
+#define OWNED 1000
+
+OwnedSlab owned_pool;
+Owned*    owned[OWNED];
+
+static void* owned_worker(void* arg) {
+  size_t count = *(size_t*)arg;
+  for (size_t i = 0; i < count; i++) {
+    owned_slab_free(&owned_pool, owned[i]);
+  }
+  return NULL;
+}
+static void owned_visit(Owned* ptr, void* ctx) {
+  ASSERT(ptr->value && *ptr->value == 7, "Foreach visited a remotely freed object");
+  (*(size_t*)ctx)++;
+}
+
+static double run(int remote, size_t workers) {
+  pthread_t ids[MAX_WORKERS];
+  use_remote = remote;
+
+  for (size_t i = 0; i < workers; i++) {
+    atomic_store(&rings[i].head, 0);
+    atomic_store(&rings[i].tail, 0);
+    pthread_create(&ids[i], NULL, worker, &rings[i]);
+  }
+
+  double start = now_ns();
+  for (uint64_t i = 0; i < MESSAGES; i++) {
+    Message* msg = NULL;
+    if (remote) {
+      msg = remote_slab_alloc(&remote_pool);
+    } else {
+      lock_slab_wrlock(&lock_pool);
+      msg = lock_slab_alloc(&lock_pool);
+      lock_slab_wrunlock(&lock_pool);
+    }
+    msg->id         = i;
+    msg->payload[6] = i * 7;
+    ring_push(&rings[i % workers], msg);
+  }
+  for (size_t i = 0; i < workers; i++) {
+    ring_push(&rings[i], NULL);
+  }
+  for (size_t i = 0; i < workers; i++) {
+    pthread_join(ids[i], NULL);
+  }
+  double elapsed = now_ns() - start;
+
+  /* Millions of messages per second */
+  return (double)MESSAGES / elapsed * 1e3;
+}
+
+int main() {
+  lock_slab_create(&lock_pool);
+  remote_slab_create(&remote_pool);
+
+  printf("%8s %14s %14s\n", "workers", "rwlock Mmsg/s", "remote Mmsg/s");
+  for (size_t workers = 1; workers <= MAX_WORKERS; workers *= 2) {
+    double locked = run(0, workers);
+    double remote = run(1, workers);
+    printf("%8zu %14.2f %14.2f\n", workers, locked, remote);
+  }
+
+  ASSERT(lock_slab_size(&lock_pool) == 0, "Locked slab leaked objects");
+  /* The last messages were freed after the last alloc, so they are still waiting for the owner */
+  ASSERT(remote_slab_collect(&remote_pool) > 0, "Remote frees were not queued");
+  ASSERT(remote_slab_size(&remote_pool) == 0, "Remote slab leaked objects");
+
+  owned_slab_create(&owned_pool);
+  for (size_t i = 0; i < OWNED; i++) {
+    owned[i] = owned_slab_alloc(&owned_pool);
+    owned[i]->value = (int*)malloc(sizeof(int));
+  }
+  size_t    count = OWNED;
+  pthread_t id;
+  pthread_create(&id, NULL, owned_worker, &count);
+  pthread_join(id, NULL);
+  ASSERT(atomic_load(&released) == OWNED && owned_slab_collect(&owned_pool) == OWNED, "Remote frees did not release owned data");
+
+  /* Half of the objects are still queued when the owner walks and clears the slab, neither may touch them again */
+  for (size_t i = 0; i < OWNED; i++) {
+    owned[i] = owned_slab_alloc(&owned_pool);
+    owned[i]->value  = (int*)malloc(sizeof(int));
+    *owned[i]->value = 7;
+  }
+  count = OWNED / 2;
+  pthread_create(&id, NULL, owned_worker, &count);
+  pthread_join(id, NULL);
+  size_t visited = 0;
+  owned_slab_foreach(&owned_pool, owned_visit, &visited);
+  ASSERT(visited == OWNED - OWNED / 2, "Foreach visited queued remote frees");
+  owned_slab_clear(&owned_pool);
+  ASSERT(atomic_load(&released) == 2 * OWNED, "Clear released remotely freed data twice");
+  owned_slab_destroy(&owned_pool);
+
+  remote_slab_destroy(&remote_pool);
+  lock_slab_destroy(&lock_pool);
+  return 0;
+}
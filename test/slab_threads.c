@@ -0,0 +1,105 @@
+#define ENABLE_RWLOCK
+#include <blop/blop.h>
+#include <time.h>
+#include <pthread.h>
+
+#define SLAB_NAME      LockSlab
+#define SLAB_FN_PREFIX lock_slab
+#define SLAB_DATA_TYPE int
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define SLAB_NAME      MagSlab
+#define SLAB_FN_PREFIX mag_slab
+#define SLAB_DATA_TYPE int
+#define SLAB_MAGAZINES
+#define SLAB_STRUCT
+#define SLAB_IMPLEMENTATION
+#include <blop/slab.h>
+
+#define MAX_THREADS 8
+#define ITERATIONS  200000
+#define BATCH       16
+
+LockSlab lock_pool;
+MagSlab  mag_pool;
+
+static double now_ns() {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void* lock_worker(void* arg) {
+  (void)arg;
+  int* ptrs[BATCH];
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    for (size_t j = 0; j < BATCH; j++) {
+      lock_slab_wrlock(&lock_pool);
+      ptrs[j] = lock_slab_alloc(&lock_pool);
+      lock_slab_wrunlock(&lock_pool);
+      *ptrs[j] = (int)j;
+    }
+    for (size_t j = 0; j < BATCH; j++) {
+      ASSERT(*ptrs[j] == (int)j, "Object shared between threads");
+      lock_slab_wrlock(&lock_pool);
+      lock_slab_free(&lock_pool, ptrs[j]);
+      lock_slab_wrunlock(&lock_pool);
+    }
+  }
+  return NULL;
+}
+static void* mag_worker(void* arg) {
+  (void)arg;
+  int* ptrs[BATCH];
+  for (size_t i = 0; i < ITERATIONS; i++) {
+    for (size_t j = 0; j < BATCH; j++) {
+      ptrs[j] = mag_slab_cache_alloc(&mag_pool);
+      *ptrs[j] = (int)j;
+    }
+    for (size_t j = 0; j < BATCH; j++) {
+      ASSERT(*ptrs[j] == (int)j, "Object shared between threads");
+      mag_slab_cache_free(&mag_pool, ptrs[j]);
+    }
+  }
+  mag_slab_cache_flush(&mag_pool);
+  return NULL;
+}
+
+static double run(void* (*worker)(void*), size_t threads) {
+  pthread_t ids[MAX_THREADS];
+
+  double start = now_ns();
+  for (size_t i = 0; i < threads; i++) {
+    pthread_create(&ids[i], NULL, worker, NULL);
+  }
+  for (size_t i = 0; i < threads; i++) {
+    pthread_join(ids[i], NULL);
+  }
+  double elapsed = now_ns() - start;
+
+  /* Millions of alloc/free pairs per second */
+  return (double)(threads * ITERATIONS * BATCH) / elapsed * 1e3;
+}
+
+int main() {
+  lock_slab_create(&lock_pool);
+  mag_slab_create(&mag_pool);
+
+  printf("%8s %14s %14s\n", "threads", "rwlock Mop/s", "magazine Mop/s");
+  for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    double locked   = run(lock_worker, threads);
+    double magazine = run(mag_worker, threads);
+    printf("%8zu %14.2f %14.2f\n", threads, locked, magazine);
+  }
+
+  mag_slab_cache_purge(&mag_pool);
+
+  ASSERT(lock_slab_size(&lock_pool) == 0, "Locked slab leaked objects");
+  ASSERT(mag_slab_size(&mag_pool) == 0, "Magazine slab leaked objects");
+
+  mag_slab_destroy(&mag_pool);
+  lock_slab_destroy(&lock_pool);
+  return 0;
+}
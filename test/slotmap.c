@@ -0,0 +1,97 @@
+#define LOG_COLOURED
+#include <blop/blop.h>
+
+typedef struct Entity {
+  float    position[2];
+  uint32_t id;
+} Entity;
+
+#define SLOTMAP_NAME      Entities
+#define SLOTMAP_FN_PREFIX entities
+#define SLOTMAP_DATA_TYPE Entity
+#define SLOTMAP_STRUCT
+#define SLOTMAP_IMPLEMENTATION
+#include <blop/slotmap.h>
+
+#define SLOTMAP_NAME       Wide
+#define SLOTMAP_FN_PREFIX  wide
+#define SLOTMAP_DATA_TYPE  int
+#define SLOTMAP_HANDLE_64
+#define SLOTMAP_STRUCT
+#define SLOTMAP_IMPLEMENTATION
+#include <blop/slotmap.h>
+
+#define OBJECTS 5000
+
+Entities_handle handles[OBJECTS];
+
+int main() {
+  ANSI_ENABLE();
+
+  Entities* map = entities_create(NULL);
+  LOG_SUCCESS("Slotmap created");
+
+  for (uint32_t i = 0; i < OBJECTS; i++) {
+    Entity entity = { { (float)i, (float)i }, i };
+    handles[i] = entities_insert(map, entity);
+    ASSERT(handles[i] != 0, "Slotmap handed out the null handle");
+  }
+  ASSERT(entities_size(map) == OBJECTS, "Slotmap size mismatch after insert");
+  LOG_SUCCESS("Objects inserted");
+
+  for (uint32_t i = 0; i < OBJECTS; i += 2) {
+    entities_erase(map, handles[i]);
+  }
+  for (uint32_t i = 0; i < OBJECTS; i++) {
+    Entity* entity = entities_get(map, handles[i]);
+    if (i % 2 == 0) {
+      ASSERT(entity == NULL && !entities_valid(map, handles[i]), "Stale handle was not detected");
+    } else {
+      ASSERT(entity && entity->id == i, "Handle lost its object after values were moved");
+    }
+  }
+  LOG_SUCCESS("Stale handles detected");
+
+  for (uint32_t i = 0; i < OBJECTS; i += 2) {
+    Entity entity = { { 0, 0 }, i };
+    Entities_handle old = handles[i];
+    handles[i] = entities_insert(map, entity);
+    ASSERT(handles[i] != old && entities_get(map, old) == NULL, "Reused slot revived a stale handle");
+  }
+  LOG_SUCCESS("Slots reused");
+
+  size_t visited = 0;
+  Entity* data = entities_data(map);
+  for (size_t i = 0; i < entities_size(map); i++) {
+    ASSERT(entities_get(map, entities_handle(map, i)) == &data[i], "Dense iteration handle mismatch");
+    visited += data[i].id < OBJECTS;
+  }
+  ASSERT(visited == OBJECTS, "Dense iteration did not visit every object");
+  LOG_SUCCESS("Objects iterated densely");
+
+  for (uint32_t i = 0; i < OBJECTS - 10; i++) {
+    entities_erase(map, handles[i]);
+  }
+  entities_compact(map);
+  ASSERT(map->capacity < OBJECTS && entities_get(map, handles[OBJECTS - 1])->id == OBJECTS - 1, "Compaction lost objects");
+  LOG_SUCCESS("Slotmap compacted");
+
+  entities_clear(map);
+  entities_destroy(map);
+  LOG_SUCCESS("Slotmap destroyed");
+
+  Wide* wide = wide_create(NULL);
+  Wide_handle handle = wide_insert(wide, 42);
+  for (int i = 0; i < 1000; i++) {
+    wide_erase(wide, handle);
+    ASSERT(wide_get(wide, handle) == NULL, "Stale 64 bit handle was not detected");
+    handle = wide_insert(wide, i);
+  }
+  ASSERT(sizeof(Wide_handle) == 8 && *wide_get(wide, handle) == 999, "64 bit handle mismatch");
+  wide_clear(wide);
+  wide_destroy(wide);
+  LOG_SUCCESS("64 bit handles checked");
+
+  ANSI_DISABLE();
+  return 0;
+}
@@ -0,0 +1,343 @@
+#define LOG_COLOURED
+#include <blop/blop.h>
+#include <time.h>
+
+#define VECTOR_NAME      Vecint
+#define VECTOR_FN_PREFIX vecint
+#define VECTOR_DATA_TYPE int
+#define VECTOR_STRUCT
+#define VECTOR_IMPLEMENTATION
+#include <blop/vector.h>
+
+#define VECTOR_NAME            Smallint
+#define VECTOR_FN_PREFIX       smallint
+#define VECTOR_DATA_TYPE       int
+#define VECTOR_INLINE_CAPACITY 8
+#define VECTOR_STRUCT
+#define VECTOR_IMPLEMENTATION
+#include <blop/vector.h>
+
+#define VECTOR_NAME      Simdint
+#define VECTOR_FN_PREFIX simdint
+#define VECTOR_DATA_TYPE int
+#define VECTOR_SIMD      i32
+#define VECTOR_STRUCT
+#define VECTOR_IMPLEMENTATION
+#include <blop/vector.h>
+
+#define VECTOR_NAME      Simdfloat
+#define VECTOR_FN_PREFIX simdfloat
+#define VECTOR_DATA_TYPE float
+#define VECTOR_SIMD      f32
+#define VECTOR_STRUCT
+#define VECTOR_IMPLEMENTATION
+#include <blop/vector.h>
+
+#define VECTOR_NAME      Scalarint
+#define VECTOR_FN_PREFIX scalarint
+#define VECTOR_DATA_TYPE int
+#define VECTOR_SUM_TYPE  int64_t
+#define VECTOR_NUMERIC
+#define VECTOR_STRUCT
+#define VECTOR_IMPLEMENTATION
+#include <blop/vector.h>
+
+typedef struct Record {
+  uint32_t key;
+  uint32_t order;
+} Record;
+
+#define VECTOR_NAME           Records
+#define VECTOR_FN_PREFIX      records
+#define VECTOR_DATA_TYPE      Record
+#define VECTOR_COMPARE(a, b)  ((a).key < (b).key)
+#define VECTOR_RADIX_KEY(x)   ((x).key)
+#define VECTOR_STRUCT
+#define VECTOR_IMPLEMENTATION
+#include <blop/vector.h>
+
+#define ELEMENTS 100000
+#define SCANNED  (1 << 24)
+#define SORTED   (1 << 22)
+
+static uint32_t random_state = 2463534242u;
+static uint32_t xorshift() {
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  return random_state;
+}
+static int compare_ints(const void* a, const void* b) {
+  int x = *(const int*)a;
+  int y = *(const int*)b;
+  return (x > y) - (x < y);
+}
+
+static double now_ns() {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main() {
+  ANSI_ENABLE();
+
+  Vecint* vec = vecint_create(NULL);
+  LOG_SUCCESS("Vector created");
+
+  for (int i = 0; i < ELEMENTS; i++) {
+    vecint_push_back(vec, i);
+  }
+  ASSERT(vecint_size(vec) == ELEMENTS, "Vector size mismatch after push");
+  for (int i = 0; i < ELEMENTS; i++) {
+    ASSERT(vecint_get(vec, i) == i, "Vector lost its contents while growing");
+  }
+  LOG_SUCCESS("Elements pushed");
+
+  vecint_insert(vec, 0, -1);
+  vecint_insert(vec, ELEMENTS / 2, -2);
+  ASSERT(vecint_front(vec) == -1 && vecint_get(vec, ELEMENTS / 2) == -2 && vecint_back(vec) == ELEMENTS - 1, "Insert misplaced elements");
+  vecint_erase(vec, ELEMENTS / 2);
+  vecint_pop_front(vec);
+  LOG_SUCCESS("Elements inserted and erased");
+
+  int*   data     = vecint_data(vec);
+  size_t capacity = vec->capacity;
+  vecint_resize(vec, ELEMENTS / 2);
+  vecint_resize(vec, ELEMENTS);
+  ASSERT(vecint_data(vec) == data && vec->capacity == capacity, "Resize within capacity reallocated");
+  ASSERT(vecint_get(vec, ELEMENTS / 2) == 0 && vecint_get(vec, ELEMENTS / 2 - 1) == ELEMENTS / 2 - 1, "Resize did not zero the new elements");
+  LOG_SUCCESS("Vector resized within capacity");
+
+  vecint_clear(vec);
+  ASSERT(vecint_size(vec) == 0 && vec->capacity == capacity, "Clear released the storage");
+  for (int i = 0; i < ELEMENTS; i++) {
+    vecint_push_back(vec, i);
+  }
+  ASSERT(vec->capacity == capacity, "Refilling a cleared vector reallocated");
+  LOG_SUCCESS("Vector cleared and refilled");
+
+  vecint_clear(vec);
+  vecint_reserve(vec, 4 * ELEMENTS);
+  data = vecint_data(vec);
+  ASSERT(vec->capacity == 4 * ELEMENTS && vecint_size(vec) == 0, "Reserve did not size the storage");
+  vecint_resize_uninit(vec, 4 * ELEMENTS);
+  for (int i = 0; i < 4 * ELEMENTS; i++) {
+    data[i] = i;
+  }
+  ASSERT(vecint_data(vec) == data && vecint_get(vec, 4 * ELEMENTS - 1) == 4 * ELEMENTS - 1, "Reserved storage was reallocated");
+  LOG_SUCCESS("Vector reserved and filled uninitialized");
+
+  size_t reallocs = 0;
+  vecint_resize(vec, vec->capacity / 4);
+  capacity = vec->capacity;
+  for (int i = 0; i < ELEMENTS; i++) {
+    vecint_pop_back(vec);
+    vecint_push_back(vec, i);
+    reallocs += vec->capacity != capacity;
+    capacity  = vec->capacity;
+  }
+  /* The first pop crosses the threshold and halves the capacity, every later push/pop fits */
+  ASSERT(reallocs == 1, "Push/pop around the shrink threshold kept reallocating");
+  while (vecint_size(vec) > 10) {
+    vecint_pop_back(vec);
+  }
+  ASSERT(vec->capacity < 4 * ELEMENTS, "Erasing did not shrink the vector");
+  vecint_shrink_to_fit(vec);
+  ASSERT(vec->capacity == 10 && vecint_back(vec) == 9, "Shrink to fit lost elements");
+  LOG_SUCCESS("Vector shrunk with hysteresis");
+
+  vecint_clear(vec);
+  int values[4] = { 1, 2, 3, 4 };
+  vecint_append(vec, values, 4);
+  vecint_insert_range(vec, 2, values, 2);
+  vecint_insert_range(vec, 0, &values[3], 1);
+  vecint_append(vec, NULL, 0);
+  vecint_extend_from(vec, vec);
+  int expected[14] = { 4, 1, 2, 1, 2, 3, 4, 4, 1, 2, 1, 2, 3, 4 };
+  ASSERT(vecint_size(vec) == 14 && memcmp(vecint_data(vec), expected, sizeof(expected)) == 0, "Bulk insertion misplaced elements");
+  LOG_SUCCESS("Elements appended in bulk");
+
+  vecint_shrink_to_fit(vec);
+  vecint_resize_uninit(vec, ELEMENTS);
+  ASSERT(vec->capacity == ELEMENTS, "Resize uninit grew past the requested size");
+  for (size_t i = 0; i < ELEMENTS; i++) {
+    vecint_set_unchecked(vec, i, (int)i);
+  }
+  long long sum = 0;
+  VECTOR_FOREACH(int, it, vec) {
+    sum += *it;
+  }
+  ASSERT(sum == (long long)ELEMENTS * (ELEMENTS - 1) / 2, "Foreach skipped elements");
+  *vecint_at(vec, 0) = -1;
+  ASSERT(vecint_get_unchecked(vec, 0) == -1 && vecint_get_unchecked(vec, ELEMENTS - 1) == ELEMENTS - 1, "Unchecked accessors mismatch");
+  LOG_SUCCESS("Vector iterated unchecked");
+
+  vecint_clear(vec);
+  vecint_destroy(vec);
+  LOG_SUCCESS("Vector destroyed");
+
+  Smallint small;
+  smallint_create(&small);
+  for (int i = 0; i < 8; i++) {
+    smallint_push_back(&small, i);
+  }
+  ASSERT(smallint_data(&small) == small.inline_data, "Small vector left its inline storage too early");
+  for (int i = 8; i < 100; i++) {
+    smallint_push_back(&small, i);
+  }
+  ASSERT(smallint_data(&small) != small.inline_data && smallint_get(&small, 99) == 99, "Small vector did not spill to the heap");
+  while (smallint_size(&small) > 5) {
+    smallint_pop_back(&small);
+  }
+  smallint_shrink_to_fit(&small);
+  ASSERT(smallint_data(&small) == small.inline_data && smallint_get(&small, 4) == 4, "Small vector did not go back inline");
+  smallint_clear(&small);
+  smallint_destroy(&small);
+  LOG_SUCCESS("Small vector kept inline");
+
+  Simdint*   simd   = simdint_create(NULL);
+  Scalarint* scalar = scalarint_create(NULL);
+  Simdfloat* floats = simdfloat_create(NULL);
+  /* Sizes around the lane and block widths so every kernel runs its scalar tail too */
+  for (int size = 1; size < 100; size++) {
+    simdint_clear(simd);
+    scalarint_clear(scalar);
+    simdfloat_clear(floats);
+    for (int i = 0; i < size; i++) {
+      int value = (i * 7919) % 61 - 30;
+      simdint_push_back(simd, value);
+      scalarint_push_back(scalar, value);
+      simdfloat_push_back(floats, (float)value);
+    }
+    for (int value = -31; value <= 31; value++) {
+      ASSERT(simdint_find(simd, value) == scalarint_find(scalar, value), "SIMD find mismatch");
+      ASSERT(simdint_count(simd, value) == scalarint_count(scalar, value), "SIMD count mismatch");
+      ASSERT(simdfloat_find(floats, (float)value) == scalarint_find(scalar, value), "SIMD float find mismatch");
+      ASSERT(simdfloat_count(floats, (float)value) == scalarint_count(scalar, value), "SIMD float count mismatch");
+    }
+    ASSERT(simdint_min(simd) == scalarint_min(scalar) && simdint_max(simd) == scalarint_max(scalar), "SIMD min/max mismatch");
+    ASSERT(simdfloat_min(floats) == (float)scalarint_min(scalar) && simdfloat_max(floats) == (float)scalarint_max(scalar), "SIMD float min/max mismatch");
+    ASSERT(simdint_sum(simd) == scalarint_sum(scalar) && simdint_dot(simd, simd) == scalarint_dot(scalar, scalar), "SIMD sum/dot mismatch");
+    /* Small integers are exact in float whatever the summation order */
+    ASSERT(simdfloat_sum(floats) == (float)scalarint_sum(scalar) && simdfloat_dot(floats, floats) == (float)scalarint_dot(scalar, scalar), "SIMD float sum/dot mismatch");
+  }
+  simdint_clear(simd);
+  scalarint_clear(scalar);
+  for (int i = 0; i < 37; i++) {
+    int value = i % 5 ? (1 << 27) + i : -(1 << 27) - i;
+    simdint_push_back(simd, value);
+    scalarint_push_back(scalar, value);
+  }
+  ASSERT(simdint_sum(simd) == scalarint_sum(scalar) && simdint_dot(simd, simd) == scalarint_dot(scalar, scalar), "SIMD sum/dot overflowed");
+  simdint_memset(simd, 1, 5, 6);
+  simdint_fill(simd, 3);
+  ASSERT(simdint_count(simd, 3) == 37, "SIMD fill missed elements");
+  LOG_SUCCESS("SIMD kernels match the scalar loops");
+
+  simdint_clear(simd);
+  scalarint_clear(scalar);
+  simdint_resize(simd, SCANNED);
+  scalarint_resize(scalar, SCANNED);
+  double start = now_ns();
+  size_t found = simdint_find(simd, 1) + simdint_count(simd, 1);
+  double simd_time = now_ns() - start;
+  start = now_ns();
+  found += scalarint_find(scalar, 1) + scalarint_count(scalar, 1);
+  double scalar_time = now_ns() - start;
+  ASSERT(found == 2 * SCANNED, "Scan found elements that are not there");
+  printf("find + count over %d ints: simd %.2f ms, scalar %.2f ms\n", SCANNED, simd_time / 1e6, scalar_time / 1e6);
+
+  /* Patterns pdqsort special cases plus random data, radix sort must agree with it */
+  for (int pattern = 0; pattern < 6; pattern++) {
+    for (int size = 0; size < 3000; size += size < 300 ? 1 : 331) {
+      simdint_clear(simd);
+      scalarint_clear(scalar);
+      for (int i = 0; i < size; i++) {
+        int value = 0;
+        switch (pattern) {
+          case 0: value = (int)xorshift(); break;
+          case 1: value = i; break;
+          case 2: value = size - i; break;
+          case 3: value = 7; break;
+          case 4: value = i < size / 2 ? i : size - i; break;
+          case 5: value = (int)(xorshift() % 4) - 2; break;
+        }
+        simdint_push_back(simd, value);
+        scalarint_push_back(scalar, value);
+      }
+      int64_t sum = scalarint_sum(scalar);
+      simdint_radix_sort(simd);
+      scalarint_sort(scalar);
+      ASSERT(memcmp(simdint_data(simd), scalarint_data(scalar), (size_t)size * sizeof(int)) == 0, "Radix sort and pdqsort disagree");
+      ASSERT(scalarint_sum(scalar) == sum, "Sort lost elements");
+      for (int i = 1; i < size; i++) {
+        ASSERT(scalarint_get(scalar, i - 1) <= scalarint_get(scalar, i), "Vector is not sorted");
+      }
+    }
+  }
+  simdfloat_clear(floats);
+  for (int i = 0; i < 1000; i++) {
+    simdfloat_push_back(floats, (float)((int)(xorshift() % 2001) - 1000) / 8.0f);
+  }
+  simdfloat_push_back(floats, -0.0f);
+  simdfloat_push_back(floats, 0.0f);
+  simdfloat_radix_sort(floats);
+  for (size_t i = 1; i < simdfloat_size(floats); i++) {
+    ASSERT(simdfloat_get(floats, i - 1) <= simdfloat_get(floats, i), "Float radix sort is not sorted");
+  }
+  LOG_SUCCESS("Vectors sorted");
+
+  Records* records = records_create(NULL);
+  for (uint32_t i = 0; i < 10000; i++) {
+    Record record = { xorshift() % 100, i };
+    records_push_back(records, record);
+  }
+  records_radix_sort(records);
+  for (size_t i = 1; i < records_size(records); i++) {
+    Record prev = records_get(records, i - 1);
+    Record cur  = records_get(records, i);
+    ASSERT(prev.key < cur.key || (prev.key == cur.key && prev.order < cur.order), "Radix sort by key is not stable");
+  }
+  records_sort(records);
+  for (size_t i = 1; i < records_size(records); i++) {
+    ASSERT(records_get(records, i - 1).key <= records_get(records, i).key, "Records are not sorted by key");
+  }
+  records_clear(records);
+  records_destroy(records);
+  LOG_SUCCESS("Records sorted by key");
+
+  simdint_resize(simd, SORTED);
+  for (size_t i = 0; i < SORTED; i++) {
+    simdint_set(simd, i, (int)xorshift());
+  }
+  int* copy = NULL;
+  CALLOC(copy, int, SORTED);
+  memcpy(copy, simdint_data(simd), SORTED * sizeof(int));
+  start = now_ns();
+  qsort(copy, SORTED, sizeof(int), compare_ints);
+  double qsort_time = now_ns() - start;
+  scalarint_clear(scalar);
+  scalarint_resize(scalar, SORTED);
+  memcpy(scalarint_data(scalar), simdint_data(simd), SORTED * sizeof(int));
+  start = now_ns();
+  scalarint_sort(scalar);
+  double pdq_time = now_ns() - start;
+  start = now_ns();
+  simdint_radix_sort(simd);
+  double radix_time = now_ns() - start;
+  ASSERT(memcmp(copy, scalarint_data(scalar), SORTED * sizeof(int)) == 0 && memcmp(copy, simdint_data(simd), SORTED * sizeof(int)) == 0, "Sorts disagree with qsort");
+  FREE(copy);
+  printf("sort %d ints: qsort %.2f ms, pdqsort %.2f ms, radix %.2f ms\n", SORTED, qsort_time / 1e6, pdq_time / 1e6, radix_time / 1e6);
+
+  simdint_clear(simd);
+  simdint_destroy(simd);
+  scalarint_clear(scalar);
+  scalarint_destroy(scalar);
+  simdfloat_clear(floats);
+  simdfloat_destroy(floats);
+  LOG_SUCCESS("Numeric vectors destroyed");
+
+  ANSI_DISABLE();
+  return 0;
+}